@@ -46,8 +46,13 @@ error "no DRIVER_CS_PINS defined"
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in snled27351_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {false};
+// g_pwm_buffer_update_required holds one bit per 16 byte block of PWM
+// registers, only the blocks which changed are transferred on flush.
+// g_pwm_buffer_total is the sum of every PWM register across all drivers,
+// kept up to date as values are set so the LED load is cheap to read.
+uint8_t  g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
+uint16_t g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {0};
+uint32_t g_pwm_buffer_total                                    = 0;
 
 uint8_t g_led_control_registers[SNLED27351_DRIVER_COUNT][SNLED27351_LED_CONTROL_REGISTER_COUNT]             = {0};
 bool    g_led_control_registers_update_required[SNLED27351_DRIVER_COUNT] = {false};
@@ -86,11 +91,7 @@ bool snled27351_write_register(uint8_t index, uint8_t page, uint8_t reg, uint8_t
 }
 
 bool snled27351_write_pwm_buffer(uint8_t index, uint8_t *pwm_buffer) {
-    if (g_pwm_buffer_update_required[index]) {
-        snled27351_write(index, LED_PWM_PAGE, 0, g_pwm_buffer[index], SNLED27351_PWM_REGISTER_COUNT);
-    }
-    g_pwm_buffer_update_required[index] = false;
-    return true;
+    return snled27351_write(index, LED_PWM_PAGE, 0, pwm_buffer, SNLED27351_PWM_REGISTER_COUNT);
 }
 
 void snled27351_init_drivers(void) {
@@ -154,8 +155,12 @@ void snled27351_set_value(int index, uint8_t value) {
     if (index >= 0 && index < SNLED27351_LED_COUNT) {
         memcpy_P(&led, (&g_snled27351_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.v]          = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        if (g_pwm_buffer[led.driver][led.v] == value) {
+            return;
+        }
+        g_pwm_buffer_total += value - g_pwm_buffer[led.driver][led.v];
+        g_pwm_buffer[led.driver][led.v] = value;
+        g_pwm_buffer_update_required[led.driver] |= 1 << (led.v / 16);
     }
 }
 
@@ -182,12 +187,26 @@ void snled27351_set_led_control_register(uint8_t index, bool value) {
 }
 
 void snled27351_update_pwm_buffers(uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        if (!snled27351_write_pwm_buffer(index, g_pwm_buffer[index])) {
+    uint8_t i = 0;
+
+    // Send each run of consecutive changed 16 byte blocks as one burst,
+    // the register address auto-increments within the page.
+    while (i < SNLED27351_PWM_REGISTER_COUNT / 16) {
+        if (!(g_pwm_buffer_update_required[index] & (1 << i))) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        while (i < SNLED27351_PWM_REGISTER_COUNT / 16 && (g_pwm_buffer_update_required[index] & (1 << i))) {
+            i++;
+        }
+        // Blocks left dirty are retried on the next flush.
+        if (!snled27351_write(index, LED_PWM_PAGE, start * 16, g_pwm_buffer[index] + start * 16, (i - start) * 16)) {
             g_led_control_registers_update_required[index] = true;
+            break;
         }
+        g_pwm_buffer_update_required[index] &= ~(((1 << (i - start)) - 1) << start);
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void snled27351_update_led_control_registers(uint8_t index) {
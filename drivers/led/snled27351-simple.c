@@ -47,8 +47,13 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in snled27351_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {false};
+// g_pwm_buffer_update_required holds one bit per 16 byte block of PWM
+// registers, only the blocks which changed are transferred on flush.
+// g_pwm_buffer_total is the sum of every PWM register across all drivers,
+// kept up to date as values are set so the LED load is cheap to read.
+uint8_t  g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
+uint16_t g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {0};
+uint32_t g_pwm_buffer_total                                    = 0;
 
 uint8_t g_led_control_registers[SNLED27351_DRIVER_COUNT][SNLED27351_LED_CONTROL_REGISTER_COUNT] = {0};
 bool    g_led_control_registers_update_required[SNLED27351_DRIVER_COUNT]                        = {false};
@@ -72,6 +77,27 @@ bool snled27351_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
+static bool snled27351_write_pwm_block(uint8_t addr, uint8_t *pwm_buffer, uint8_t offset) {
+    g_twi_transfer_buffer[0] = offset;
+    // Copy the data from offset to offset+15.
+    // Device will auto-increment register for data after the first byte
+    // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
+    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + offset, 16);
+
+#if SNLED27351_I2C_PERSISTENCE > 0
+    for (uint8_t i = 0; i < SNLED27351_I2C_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, SNLED27351_I2C_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, SNLED27351_I2C_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
 bool snled27351_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
@@ -80,25 +106,9 @@ bool snled27351_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
     for (int i = 0; i < SNLED27351_PWM_REGISTER_COUNT; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
-
-#if SNLED27351_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < SNLED27351_I2C_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, SNLED27351_I2C_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, SNLED27351_I2C_TIMEOUT) != 0) {
+        if (!snled27351_write_pwm_block(addr, pwm_buffer, i)) {
             return false;
         }
-#endif
     }
     return true;
 }
@@ -187,8 +197,9 @@ void snled27351_set_value(int index, uint8_t value) {
         if (g_pwm_buffer[led.driver][led.v] == value) {
             return;
         }
-        g_pwm_buffer[led.driver][led.v]          = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        g_pwm_buffer_total += value - g_pwm_buffer[led.driver][led.v];
+        g_pwm_buffer[led.driver][led.v] = value;
+        g_pwm_buffer_update_required[led.driver] |= 1 << (led.v / 16);
     }
 }
 
@@ -218,13 +229,21 @@ void snled27351_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
         snled27351_write_register(addr, SNLED27351_REG_COMMAND, SNLED27351_COMMAND_PWM);
 
-        // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!snled27351_write_pwm_buffer(addr, g_pwm_buffer[index])) {
-            g_led_control_registers_update_required[index] = true;
+        // Only transfer the 16 byte blocks which changed.
+        for (uint8_t i = 0; i < SNLED27351_PWM_REGISTER_COUNT / 16; i++) {
+            if (!(g_pwm_buffer_update_required[index] & (1 << i))) {
+                continue;
+            }
+            // If any of the transactions fail we risk writing dirty PG0,
+            // refresh page 0 just in case. Blocks left dirty are retried
+            // on the next flush.
+            if (!snled27351_write_pwm_block(addr, g_pwm_buffer[index], i * 16)) {
+                g_led_control_registers_update_required[index] = true;
+                break;
+            }
+            g_pwm_buffer_update_required[index] &= ~(1 << i);
         }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void snled27351_update_led_control_registers(uint8_t addr, uint8_t index) {
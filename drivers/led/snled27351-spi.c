@@ -46,15 +46,24 @@ error "no DRIVER_CS_PINS defined"
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in snled27351_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {false};
+// g_pwm_buffer_update_required holds one bit per 16 byte block of PWM
+// registers, only the blocks which changed are transferred on flush.
+// g_pwm_buffer_total is the sum of every PWM register across all drivers,
+// kept up to date as values are set so the LED load is cheap to read.
+uint8_t  g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
+uint16_t g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {0};
+uint32_t g_pwm_buffer_total                                    = 0;
 
 uint8_t g_led_control_registers[SNLED27351_DRIVER_COUNT][SNLED27351_LED_CONTROL_REGISTER_COUNT]             = {0};
 bool    g_led_control_registers_update_required[SNLED27351_DRIVER_COUNT] = {false};
 
+#ifdef SNLED27351_ASYNC_FLUSH
+#    ifndef SNLED27351_SPI_TIMEOUT
+#        define SNLED27351_SPI_TIMEOUT 100
+#    endif
+#endif
 
-
-bool snled27351_write(uint8_t index, uint8_t page, uint8_t reg, uint8_t *data, uint8_t len) {
+static bool snled27351_select(uint8_t index, uint8_t page, uint8_t reg) {
     static uint8_t spi_transfer_buffer[2] = {0};
 
     if (index > ARRAY_SIZE(((pin_t[])DRIVER_CS_PINS)) - 1) return false;
@@ -71,14 +80,26 @@ bool snled27351_write(uint8_t index, uint8_t page, uint8_t reg, uint8_t *data, u
         spi_stop();
         return false;
     }
+    return true;
+}
 
-    if (spi_transmit(data, len) != SPI_STATUS_SUCCESS) {
-        spi_stop();
+bool snled27351_write(uint8_t index, uint8_t page, uint8_t reg, uint8_t *data, uint8_t len) {
+    if (!snled27351_select(index, page, reg)) {
         return false;
     }
 
+#ifdef SNLED27351_ASYNC_FLUSH
+    // Sleep on the DMA end interrupt, but give up on a stuck bus
+    spi_status_t status = spi_transmit_async(data, len);
+    if (status == SPI_STATUS_SUCCESS) {
+        status = spi_transmit_wait(SNLED27351_SPI_TIMEOUT);
+    }
+#else
+    spi_status_t status = spi_transmit(data, len);
+#endif
+
     spi_stop();
-    return true;
+    return status == SPI_STATUS_SUCCESS;
 }
 
 bool snled27351_write_register(uint8_t index, uint8_t page, uint8_t reg, uint8_t data) {
@@ -86,11 +107,7 @@ bool snled27351_write_register(uint8_t index, uint8_t page, uint8_t reg, uint8_t
 }
 
 bool snled27351_write_pwm_buffer(uint8_t index, uint8_t *pwm_buffer) {
-    if (g_pwm_buffer_update_required[index]) {
-        snled27351_write(index, LED_PWM_PAGE, 0, g_pwm_buffer[index], SNLED27351_PWM_REGISTER_COUNT);
-    }
-    g_pwm_buffer_update_required[index] = false;
-    return true;
+    return snled27351_write(index, LED_PWM_PAGE, 0, pwm_buffer, SNLED27351_PWM_REGISTER_COUNT);
 }
 
 void snled27351_init_drivers(void) {
@@ -154,10 +171,14 @@ void snled27351_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < SNLED27351_LED_COUNT) {
         memcpy_P(&led, (&g_snled27351_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
+            return;
+        }
+        g_pwm_buffer_total += (red + green + blue) - (g_pwm_buffer[led.driver][led.r] + g_pwm_buffer[led.driver][led.g] + g_pwm_buffer[led.driver][led.b]);
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        g_pwm_buffer_update_required[led.driver] |= (1 << (led.r / 16)) | (1 << (led.g / 16)) | (1 << (led.b / 16));
     }
 }
 
@@ -198,12 +219,26 @@ void snled27351_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void snled27351_update_pwm_buffers(uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        if (!snled27351_write_pwm_buffer(index, g_pwm_buffer[index])) {
+    uint8_t i = 0;
+
+    // Send each run of consecutive changed 16 byte blocks as one burst,
+    // the register address auto-increments within the page.
+    while (i < SNLED27351_PWM_REGISTER_COUNT / 16) {
+        if (!(g_pwm_buffer_update_required[index] & (1 << i))) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        while (i < SNLED27351_PWM_REGISTER_COUNT / 16 && (g_pwm_buffer_update_required[index] & (1 << i))) {
+            i++;
+        }
+        // Blocks left dirty are retried on the next flush.
+        if (!snled27351_write(index, LED_PWM_PAGE, start * 16, g_pwm_buffer[index] + start * 16, (i - start) * 16)) {
             g_led_control_registers_update_required[index] = true;
+            break;
         }
+        g_pwm_buffer_update_required[index] &= ~(((1 << (i - start)) - 1) << start);
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void snled27351_update_led_control_registers(uint8_t index) {
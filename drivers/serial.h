@@ -28,6 +28,12 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SERIAL_DRIVER_USART_DMA
+// start a transaction and collect its result later, only one can be in flight
+bool soft_serial_transaction_start(int sstd_index);
+bool soft_serial_transaction_finish(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -16,6 +16,18 @@
 
 #include "quantum.h"
 
+/* Define DRIVE_SHRIFT_REGISTER_WITH_SPI to clock the 74HC595 chain out of a
+ * hardware SPI peripheral instead of bit-banging it. SHCP must be wired to
+ * SCK and DS to MOSI of HC595_SPI_DRIVER, STCP stays a GPIO. Which
+ * peripheral and alternate function reach those pins depends on the MCU and
+ * the board, so there are no defaults for them.
+ */
+#ifdef DRIVE_SHRIFT_REGISTER_WITH_SPI
+#    if !defined(HC595_SPI_DRIVER) || !defined(HC595_SPI_PAL_MODE) || !defined(HC595_SHCP) || !defined(HC595_DS)
+#        error "DRIVE_SHRIFT_REGISTER_WITH_SPI requires HC595_SPI_DRIVER, HC595_SPI_PAL_MODE, HC595_SHCP (SCK) and HC595_DS (MOSI) to be defined together"
+#    endif
+#endif
+
 #ifndef HC595_STCP
 #    define HC595_STCP B0
 #endif
@@ -36,6 +48,20 @@
 #    define HC595_OFFSET_INDEX 0
 #endif
 
+#ifdef DRIVE_SHRIFT_REGISTER_WITH_SPI
+#    ifndef HC595_SPI_CR1
+#        define HC595_SPI_CR1 (SPI_CR1_BR_1)
+#    endif
+#    ifndef HC595_SPI_CR2
+#        if defined(SPI_CR2_DS_Pos)
+#            define HC595_SPI_CR2 (SPI_CR2_DS_2 | SPI_CR2_DS_1 | SPI_CR2_DS_0)
+#        else
+#            define HC595_SPI_CR2 0U
+#        endif
+#    endif
+#    define HC595_BYTES ((HC595_END_INDEX - HC595_START_INDEX + 8) / 8)
+#endif
+
 #if defined(HC595_START_INDEX) && defined(HC595_END_INDEX)
 #    if ((HC595_END_INDEX - HC595_START_INDEX + 1) > 16)
 #        define SIZE_T uint32_t
@@ -55,6 +81,15 @@
 pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
 pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
 
+/* When no key is pressed, all cols are kept selected and only row pins are
+ * checked on each scan, a full col by col scan is performed only when any
+ * row goes low or while any key is held. Define MATRIX_NO_IDLE_SCAN to always
+ * perform full scans.
+ */
+#ifndef MATRIX_NO_IDLE_SCAN
+static bool matrix_idle = false;
+#endif
+
 static inline uint8_t readMatrixPin(pin_t pin) {
     if (pin != NO_PIN) {
         return readPin(pin);
@@ -79,6 +114,46 @@ static inline void HC595_delay(uint16_t n) {
     }
 }
 
+#ifdef DRIVE_SHRIFT_REGISTER_WITH_SPI
+// clang-format off
+static const SPIConfig hc595_spicfg = {
+    .circular = false,
+    .slave    = false,
+    .data_cb  = NULL,
+    .error_cb = NULL,
+    .ssport   = PAL_PORT(HC595_STCP),
+    .sspad    = PAL_PAD(HC595_STCP),
+    .cr1      = SPI_CR1_MSTR | HC595_SPI_CR1,
+    .cr2      = HC595_SPI_CR2,
+};
+// clang-format on
+
+/* Shadow of the shift register outputs, bit n is Qn of the chain */
+static uint32_t hc595_state = 0;
+
+static void HC595_output(SIZE_T data, bool bit_flag) {
+    /* Mirror what the bit-banged shift would do, then send the whole chain */
+    for (uint8_t i = 0; i < (HC595_END_INDEX - HC595_START_INDEX + 1); i++) {
+        hc595_state = (hc595_state << 1) | (data & 0x1);
+        if (bit_flag) {
+            break;
+        } else {
+            data = data >> 1;
+        }
+    }
+
+    /* A column step is one byte per 8 columns of the chain, too short to be
+     * worth setting up DMA and waiting for the driver to wake the thread, so
+     * the data register is polled and STCP pulsed directly. The first bit
+     * sent ends up in the last stage of the chain. */
+    for (uint8_t i = 0; i < HC595_BYTES; i++) {
+        spiPolledExchange(&HC595_SPI_DRIVER, (hc595_state >> ((HC595_BYTES - 1 - i) * 8)) & 0xFF);
+    }
+    writePinHigh(HC595_STCP); // rising edge latches the outputs
+    HC595_delay(1);
+    writePinLow(HC595_STCP);
+}
+#else
 static void HC595_output(SIZE_T data, bool bit_flag) {
     uint8_t n = 1;
 
@@ -105,6 +180,7 @@ static void HC595_output(SIZE_T data, bool bit_flag) {
         HC595_delay(n);
     }
 }
+#endif
 
 static void select_col(uint8_t col) {
     if (col < HC595_START_INDEX || col > HC595_END_INDEX) {
@@ -140,10 +216,9 @@ static void unselect_cols(void) {
             setPinInputHigh(col_pins[col]);
 #endif
         } else {
-            if (col == HC595_START_INDEX) {
-                HC595_output(UNSELECT_ALL_COL, false);
-            }
-            break;
+            // The whole chain is driven at once, carry on with the pins after it
+            HC595_output(UNSELECT_ALL_COL, false);
+            col = HC595_END_INDEX;
         }
     }
 }
@@ -153,10 +228,9 @@ void select_all_cols(void) {
         if (col < HC595_START_INDEX || col > HC595_END_INDEX) {
             setPinOutput_writeLow(col_pins[col]);
         } else {
-            if (col == HC595_START_INDEX) {
-                HC595_output(SELECT_ALL_COL, false);
-            }
-            break;
+            // The whole chain is driven at once, carry on with the pins after it
+            HC595_output(SELECT_ALL_COL, false);
+            col = HC595_END_INDEX;
         }
     }
 }
@@ -183,10 +257,40 @@ static void matrix_read_rows_on_col(matrix_row_t current_matrix[], uint8_t curre
     HC595_delay(200); // wait for all Row signals to go HIGH
 }
 
+#ifndef MATRIX_NO_IDLE_SCAN
+static bool matrix_any_row_active(void) {
+    for (uint8_t row_index = 0; row_index < MATRIX_ROWS; row_index++) {
+        if (readMatrixPin(row_pins[row_index]) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool matrix_any_key_down(matrix_row_t current_matrix[]) {
+    for (uint8_t row_index = 0; row_index < MATRIX_ROWS; row_index++) {
+        if (current_matrix[row_index]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
 void matrix_init_custom(void) {
+#ifdef DRIVE_SHRIFT_REGISTER_WITH_SPI
+    palSetLineMode(HC595_SHCP, PAL_MODE_ALTERNATE(HC595_SPI_PAL_MODE) | PAL_STM32_OSPEED_HIGHEST); /* SCK */
+    palSetLineMode(HC595_DS, PAL_MODE_ALTERNATE(HC595_SPI_PAL_MODE) | PAL_STM32_OSPEED_HIGHEST);   /* MOSI */
+    setPinOutput(HC595_STCP);
+    writePinLow(HC595_STCP);
+    spiStart(&HC595_SPI_DRIVER, &hc595_spicfg);
+#else
     setPinOutput(HC595_DS);
     setPinOutput(HC595_STCP);
     setPinOutput(HC595_SHCP);
+#endif
 
     for (uint8_t x = 0; x < MATRIX_ROWS; x++) {
         if (row_pins[x] != NO_PIN) {
@@ -195,11 +299,25 @@ void matrix_init_custom(void) {
     }
 
     unselect_cols();
+#ifndef MATRIX_NO_IDLE_SCAN
+    matrix_idle = false;
+#endif
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+#ifndef MATRIX_NO_IDLE_SCAN
+    if (matrix_idle) {
+        // Nothing changed if no row is pulled low by any of the selected cols
+        if (!matrix_any_row_active()) return false;
+
+        matrix_idle = false;
+        unselect_cols();
+        HC595_delay(200);
+    }
+#endif
+
     // Set col, read rows
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
@@ -209,6 +327,13 @@ bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     bool changed = memcmp(current_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(current_matrix, curr_matrix, sizeof(curr_matrix));
 
+#ifndef MATRIX_NO_IDLE_SCAN
+    if (!matrix_any_key_down(curr_matrix)) {
+        select_all_cols();
+        matrix_idle = true;
+    }
+#endif
+
     return changed;
 }
 
@@ -51,12 +51,24 @@
 #    define VOLTAGE_TRIM_RGB_MATRIX 60
 #endif
 
+/* Weight of a new sample in the running voltage average, 1 / (1 << n) */
+#ifndef VOLTAGE_FILTER_SHIFT
+#    define VOLTAGE_FILTER_SHIFT 2
+#endif
+
+/* Reported percentage only moves once it is this many steps away */
+#ifndef BATTERY_PERCENTAGE_HYSTERESIS
+#    define BATTERY_PERCENTAGE_HYSTERESIS 2
+#endif
+
 #if defined(LED_MATRIX_ENABLE) || defined(RGB_MATRIX_ENABLE)
-extern uint8_t g_pwm_buffer[DRIVER_COUNT][192];
+extern uint32_t g_pwm_buffer_total;
 #endif
 
 static uint32_t bat_monitor_timer_buffer = 0;
 static uint16_t voltage                  = FULL_VOLTAGE_VALUE;
+static uint32_t voltage_sum              = 0; // voltage << VOLTAGE_FILTER_SHIFT, 0 until the first sample
+static uint8_t  percentage               = 0xFF;
 static uint8_t  bat_empty                = 0;
 static uint8_t  critical_low             = 0;
 static uint8_t  bat_state;
@@ -97,52 +109,49 @@ __attribute__((weak)) void battery_measure(void) {
     lkbt51_read_state_reg(0x05, 0x02);
 }
 
+/* Voltage drop caused by the current drawn by the backlight */
+static uint16_t battery_led_load_compensation(void) {
+    /* We assumpt it is linear relationship*/
+#ifdef LED_MATRIX_ENABLE
+    if (led_matrix_is_enabled()) return VOLTAGE_TRIM_LED_MATRIX * g_pwm_buffer_total / LED_MATRIX_LED_COUNT / 255;
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_is_enabled()) return VOLTAGE_TRIM_RGB_MATRIX * g_pwm_buffer_total / RGB_MATRIX_LED_COUNT / 255 / 3;
+#endif
+    return 0;
+}
+
 /* Calculate the voltage */
 __attribute__((weak)) void battery_calculate_voltage(bool vol_src_bt, uint16_t value) {
-    uint16_t voltage;
+    uint16_t sample;
 
     if (vol_src_bt)
-        voltage = ((uint32_t)value) * (LKBT51_RVD_R1 + LKBT51_RVD_R2) / LKBT51_RVD_R2;
+        sample = ((uint32_t)value) * (LKBT51_RVD_R1 + LKBT51_RVD_R2) / LKBT51_RVD_R2;
     else
-        voltage = (uint32_t)value * 3300 / 1024 * (RVD_R1 + RVD_R2) / RVD_R2;
-
-#ifdef LED_MATRIX_ENABLE
-    if (led_matrix_is_enabled()) {
-        uint32_t totalBuf = 0;
-
-        for (uint8_t i = 0; i < DRIVER_COUNT; i++)
-            for (uint8_t j = 0; j < 192; j++)
-                totalBuf += g_pwm_buffer[i][j];
-        /* We assumpt it is linear relationship*/
-        voltage += (VOLTAGE_TRIM_LED_MATRIX * totalBuf / LED_MATRIX_LED_COUNT / 255);
-    }
-#endif
-#ifdef RGB_MATRIX_ENABLE
-    if (rgb_matrix_is_enabled()) {
-        uint32_t totalBuf = 0;
+        sample = (uint32_t)value * 3300 / 1024 * (RVD_R1 + RVD_R2) / RVD_R2;
 
-        for (uint8_t i = 0; i < DRIVER_COUNT; i++)
-            for (uint8_t j = 0; j < 192; j++)
-                totalBuf += g_pwm_buffer[i][j];
-        /* We assumpt it is linear relationship*/
-        uint32_t compensation = VOLTAGE_TRIM_RGB_MATRIX * totalBuf / RGB_MATRIX_LED_COUNT / 255 / 3;
+    sample += battery_led_load_compensation();
 
-        voltage += compensation;
+    /* Running average, so a single noisy sample or a lighting change
+     * only moves the estimate by a fraction of the difference */
+    if (voltage_sum == 0) {
+        battery_set_voltage(sample);
+    } else {
+        voltage_sum = voltage_sum - voltage + sample;
+        voltage     = voltage_sum >> VOLTAGE_FILTER_SHIFT;
     }
-#endif
-
-    battery_set_voltage(voltage);
 }
 
 void battery_set_voltage(uint16_t value) {
-    voltage = value;
+    voltage     = value;
+    voltage_sum = (uint32_t)value << VOLTAGE_FILTER_SHIFT;
 }
 
 uint16_t battery_get_voltage(void) {
     return voltage;
 }
 
-uint8_t battery_get_percentage(void) {
+static uint8_t battery_voltage_to_percentage(uint16_t voltage) {
     if (voltage > FULL_VOLTAGE_VALUE) return 100;
 
     if (voltage > EMPTY_VOLTAGE_VALUE) {
@@ -155,6 +164,18 @@ uint8_t battery_get_percentage(void) {
         return 0;
 }
 
+uint8_t battery_get_percentage(void) {
+    uint8_t level = battery_voltage_to_percentage(voltage);
+
+    /* Don't flicker between two neighbouring levels, but always report
+     * the end points so full and empty are never held back */
+    if (percentage > 100 || level == 0 || level == 100 || level >= percentage + BATTERY_PERCENTAGE_HYSTERESIS || level + BATTERY_PERCENTAGE_HYSTERESIS <= percentage) {
+        percentage = level;
+    }
+
+    return percentage;
+}
+
 bool battery_is_empty(void) {
     return bat_empty > BATTERY_EMPTY_COUNT;
 }
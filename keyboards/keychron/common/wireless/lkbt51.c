@@ -49,6 +49,11 @@ extern void factory_test_send(uint8_t* payload, uint8_t length);
 #    define SPI_MOSI_PAL_MODE 5
 #endif
 
+/* After the pin defaults above, spi_master.h has its own */
+#ifdef SPI_DRIVER
+#    include "spi_master.h"
+#endif
+
 #ifndef LKBT51_INT_INPUT_PIN
 #    error "LKBT51_INT_INPUT_PIN is not defined"
 #endif
@@ -57,6 +62,17 @@ extern void factory_test_send(uint8_t* payload, uint8_t length);
 #    define LKBT51_TX_RETRY_COUNT 3
 #endif
 
+#ifndef LKBT51_TX_QUEUE_SIZE
+#    define LKBT51_TX_QUEUE_SIZE 4
+#endif
+
+/* A read frame is the read command, the module status block and then an optional packet */
+#define READ_CMD_LEN 4
+#define STATUS_BLOCK_LEN 10
+#define READ_PREFIX_LEN (READ_CMD_LEN + STATUS_BLOCK_LEN + PACKECT_HEADER_LEN)
+#define LINK_TX_TIMEOUT TIME_MS2I(100)
+#define LINK_RECLAIM_TIMEOUT_MS 10
+
 // clang-format off
 enum {
     /* HID Report  */
@@ -148,6 +164,35 @@ static uint8_t  expect_len          = 22;
 static uint16_t connection_interval = 1;
 static uint32_t wake_time;
 
+typedef enum {
+    LINK_IDLE,
+    LINK_TX,
+    LINK_RX_PREFIX,
+    LINK_RX_PACKET,
+    LINK_HELD,
+    LINK_LENT,
+} link_state_t;
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[PACKET_MAX_LEN];
+} link_packet_t;
+
+static link_packet_t         tx_queue[LKBT51_TX_QUEUE_SIZE];
+static uint8_t               tx_head;
+static uint8_t               tx_tail;
+static volatile uint8_t      tx_count;
+static uint8_t               rx_cmd[PACKET_MAX_LEN];
+static uint8_t               rx_buf[PACKET_MAX_LEN];
+static uint8_t               rx_len;
+static volatile bool         rx_requested;
+static volatile bool         rx_ready;
+static volatile link_state_t link_state = LINK_HELD;
+static link_state_t          link_lent_from;
+static threads_queue_t       link_waiters;
+
+static void lkbt51_spi_cb(SPIDriver* spip);
+
 // clang-format off
 wt_func_t wireless_transport = {
     lkbt51_init,
@@ -168,7 +213,7 @@ wt_func_t wireless_transport = {
 const SPIConfig spicfg = {
     .circular = false,
     .slave    = false,
-    .data_cb  = NULL,
+    .data_cb  = lkbt51_spi_cb,
     .error_cb = NULL,
     .ssport   = PAL_PORT(BLUETOOTH_INT_OUTPUT_PIN),
     .sspad    = PAL_PAD(BLUETOOTH_INT_OUTPUT_PIN),
@@ -176,6 +221,189 @@ const SPIConfig spicfg = {
     .cr2      = 0U,
 };
 
+/* Starts the next transfer if the bus is free. Reads take priority over queued packets. */
+static void lkbt51_link_kick_i(void) {
+    if (link_state != LINK_IDLE) return;
+
+    if (rx_requested && !rx_ready) {
+        rx_requested = false;
+        rx_len       = MIN(READ_PREFIX_LEN, READ_CMD_LEN + expect_len);
+        link_state   = LINK_RX_PREFIX;
+        spiSelectI(&WT_DRIVER);
+        spiStartExchangeI(&WT_DRIVER, rx_len, rx_cmd, rx_buf);
+    } else if (tx_count) {
+        link_state = LINK_TX;
+        spiSelectI(&WT_DRIVER);
+        spiStartSendI(&WT_DRIVER, tx_queue[tx_tail].len, tx_queue[tx_tail].data);
+    }
+}
+
+/* DMA completion, runs in interrupt context */
+static void lkbt51_spi_cb(SPIDriver* spip) {
+    osalSysLockFromISR();
+    switch (link_state) {
+        case LINK_RX_PREFIX: {
+            /* Keep the frame open and clock in exactly the packet the header announces */
+            uint8_t* hdr = &rx_buf[READ_CMD_LEN + STATUS_BLOCK_LEN];
+            if (rx_len == READ_PREFIX_LEN && hdr[0] == 0xAA && hdr[1] == 0x57 && (~hdr[2] & 0xFF) == hdr[3]) {
+                uint8_t len = MIN(hdr[2], PACKET_MAX_LEN - READ_PREFIX_LEN);
+                if (len) {
+                    link_state = LINK_RX_PACKET;
+                    spiStartExchangeI(spip, len, &rx_cmd[rx_len], &rx_buf[rx_len]);
+                    rx_len += len;
+                    break;
+                }
+            }
+        }
+            // fall through
+        case LINK_RX_PACKET:
+            spiUnselectI(spip);
+            rx_ready   = true;
+            link_state = LINK_IDLE;
+            lkbt51_link_kick_i();
+            break;
+        case LINK_TX:
+            spiUnselectI(spip);
+            tx_tail    = (tx_tail + 1) % LKBT51_TX_QUEUE_SIZE;
+            tx_count   = tx_count - 1;
+            link_state = LINK_IDLE;
+            lkbt51_link_kick_i();
+            break;
+        default:
+            /* Synchronous transfer made while the link is held */
+            break;
+    }
+    osalThreadDequeueAllI(&link_waiters, MSG_OK);
+    osalSysUnlockFromISR();
+}
+
+static void lkbt51_int_cb(void* arg) {
+    (void)arg;
+
+    osalSysLockFromISR();
+    rx_requested = true;
+    lkbt51_link_kick_i();
+    osalSysUnlockFromISR();
+}
+
+#ifdef SPI_DRIVER
+/* The LED drivers share the peripheral through spi_master on most boards. While
+ * spi_master has it, the link is LINK_LENT and the interrupt and DMA callbacks
+ * leave the bus alone. */
+#    define LKBT51_SPI_SHARED (&WT_DRIVER == &SPI_DRIVER)
+
+void spi_bus_acquire_kb(void) {
+    if (!LKBT51_SPI_SHARED) return;
+
+    osalSysLock();
+    while (link_state == LINK_TX || link_state == LINK_RX_PREFIX || link_state == LINK_RX_PACKET)
+        osalThreadEnqueueTimeoutS(&link_waiters, TIME_INFINITE);
+    link_lent_from = link_state;
+    link_state     = LINK_LENT;
+    osalSysUnlock();
+}
+
+void spi_bus_release_kb(void) {
+    if (!LKBT51_SPI_SHARED) return;
+
+    /* spi_master stopped the driver, every queued transfer needs our configuration again */
+    if (link_lent_from == LINK_IDLE) spiStart(&WT_DRIVER, &spicfg);
+
+    osalSysLock();
+    link_state = link_lent_from;
+    lkbt51_link_kick_i();
+    osalSysUnlock();
+}
+
+/* spi_master only keeps the bus between calls while an asynchronous transfer
+ * is on it, so the main loop would wait forever for it to give the bus back.
+ * A transfer that has not finished in time is cut short by spi_stop(). */
+static void lkbt51_link_reclaim(void) {
+    if (link_state == LINK_LENT) {
+        spi_transmit_wait(LINK_RECLAIM_TIMEOUT_MS);
+        spi_stop();
+    }
+}
+#else
+static inline void lkbt51_link_reclaim(void) {}
+#endif
+
+static void lkbt51_link_start(void) {
+    lkbt51_link_reclaim();
+    osalThreadQueueObjectInit(&link_waiters);
+
+    tx_head      = 0;
+    tx_tail      = 0;
+    tx_count     = 0;
+    rx_requested = false;
+    rx_ready     = false;
+
+    memset(rx_cmd, 0, sizeof(rx_cmd));
+    rx_cmd[0] = 0x84;
+    rx_cmd[1] = 0x7f;
+    rx_cmd[2] = 0x00;
+    rx_cmd[3] = 0x80;
+
+    spiStart(&WT_DRIVER, &spicfg);
+
+    /* The INT line also wakes the MCU from low power mode, so it stays armed until the next init */
+    palDisableLineEvent(LKBT51_INT_INPUT_PIN);
+    palEnableLineEvent(LKBT51_INT_INPUT_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+    palSetLineCallback(LKBT51_INT_INPUT_PIN, lkbt51_int_cb, NULL);
+
+    link_state = LINK_IDLE;
+}
+
+/* Waits for queued packets and reads in flight to finish, then keeps the bus for the caller */
+static void lkbt51_link_acquire(void) {
+    lkbt51_link_reclaim();
+
+    osalSysLock();
+    while (link_state != LINK_IDLE && link_state != LINK_HELD)
+        osalThreadEnqueueTimeoutS(&link_waiters, TIME_INFINITE);
+    link_state = LINK_HELD;
+    osalSysUnlock();
+}
+
+static void lkbt51_link_release(void) {
+    osalSysLock();
+    link_state = LINK_IDLE;
+    lkbt51_link_kick_i();
+    osalSysUnlock();
+}
+
+/* Queues a packet, false if the queue did not drain in time and the packet was not sent */
+static bool lkbt51_link_send(uint8_t* data, uint8_t len) {
+    /* Nothing drains the queue while spi_master has the bus */
+    if (tx_count == LKBT51_TX_QUEUE_SIZE) lkbt51_link_reclaim();
+
+    osalSysLock();
+    while (tx_count == LKBT51_TX_QUEUE_SIZE) {
+        if (osalThreadEnqueueTimeoutS(&link_waiters, LINK_TX_TIMEOUT) == MSG_TIMEOUT) {
+            osalSysUnlock();
+            return false;
+        }
+    }
+    osalSysUnlock();
+
+    /* The slot at the head is not visible to the DMA side until tx_count includes it */
+    tx_queue[tx_head].len = len;
+    memcpy(tx_queue[tx_head].data, data, len);
+
+    osalSysLock();
+    tx_head  = (tx_head + 1) % LKBT51_TX_QUEUE_SIZE;
+    tx_count = tx_count + 1;
+    lkbt51_link_kick_i();
+    osalSysUnlock();
+
+    return true;
+}
+
+void lkbt51_stop(void) {
+    lkbt51_link_acquire();
+    spiStop(&WT_DRIVER);
+}
+
 void lkbt51_init(bool wakeup_from_low_power_mode) {
 #ifdef LKBT51_RESET_PIN
     if (!wakeup_from_low_power_mode) {
@@ -195,11 +423,6 @@ void lkbt51_init(bool wakeup_from_low_power_mode) {
         palSetLineMode(SPI_MISO_PIN, PAL_MODE_ALTERNATE(SPI_MISO_PAL_MODE));
         palSetLineMode(SPI_MOSI_PIN, PAL_MODE_ALTERNATE(SPI_MOSI_PAL_MODE));
 
-        if (wakeup_from_low_power_mode) {
-            spiInit();
-            return;
-        }
-
         spiInit();
     }
 #endif
@@ -208,16 +431,23 @@ void lkbt51_init(bool wakeup_from_low_power_mode) {
     writePinHigh(BLUETOOTH_INT_OUTPUT_PIN);
 
     setPinInputHigh(LKBT51_INT_INPUT_PIN);
+
+#if HAL_USE_SPI
+    lkbt51_link_start();
+#endif
 }
 
 static inline void lkbt51_wake(void) {
     if (timer_elapsed32(wake_time) > 3000) {
         wake_time = timer_read32();
 
+        /* The wake line doubles as the chip select, so the bus has to be idle */
+        lkbt51_link_acquire();
         palWriteLine(BLUETOOTH_INT_OUTPUT_PIN, 0);
         wait_ms(10);
         palWriteLine(BLUETOOTH_INT_OUTPUT_PIN, 1);
         wait_ms(300);
+        lkbt51_link_release();
     }
 }
 
@@ -239,16 +469,12 @@ void lkbt51_send_protocol_ver(uint16_t ver) {
     pkt[i++] = (uint8_t)(~0xAA);
 
 #if HAL_USE_SPI
-    expect_len = 10;
-    spiStart(&WT_DRIVER, &spicfg);
-    spiSelect(&WT_DRIVER);
-    spiSend(&WT_DRIVER, i, pkt);
-    spiUnselectI(&WT_DRIVER);
-    spiStop(&WT_DRIVER);
+    expect_len = STATUS_BLOCK_LEN;
+    lkbt51_link_send(pkt, i);
 #endif
 }
 
-void lkbt51_send_cmd(uint8_t* payload, uint8_t len, bool ack_enable, bool retry) {
+bool lkbt51_send_cmd(uint8_t* payload, uint8_t len, bool ack_enable, bool retry) {
     static uint8_t sn = 0;
     uint8_t        i;
     uint8_t        pkt[PACKET_MAX_LEN] = {0};
@@ -277,42 +503,14 @@ void lkbt51_send_cmd(uint8_t* payload, uint8_t len, bool ack_enable, bool retry)
     pkt[i++] = checksum & 0xFF;
     pkt[i++] = (checksum >> 8) & 0xFF;
 #if HAL_USE_SPI
-    if ((payload[0] & 0xF0) == 0x60)
-        expect_len = 64;
-    else
-        expect_len = 64;
-
-    spiStart(&WT_DRIVER, &spicfg);
-    spiSelect(&WT_DRIVER);
-    spiSend(&WT_DRIVER, i, pkt);
-    spiUnselectI(&WT_DRIVER);
-    spiStop(&WT_DRIVER);
-#endif
-}
-
-void lkbt51_read(uint8_t* payload, uint8_t len) {
-    uint8_t i;
-    uint8_t pkt[PACKET_MAX_LEN] = {0};
-    memset(pkt, 0, PACKET_MAX_LEN);
-
-    i        = 0;
-    pkt[i++] = 0x84;
-    pkt[i++] = 0x7f;
-    pkt[i++] = 0x00;
-    pkt[i++] = 0x80;
-
-    i += len;
-
-#if HAL_USE_SPI
-    spiStart(&WT_DRIVER, &spicfg);
-    spiSelect(&WT_DRIVER);
-    spiExchange(&WT_DRIVER, i, pkt, payload);
-    spiUnselect(&WT_DRIVER);
-    spiStop(&WT_DRIVER);
+    expect_len = PACKET_MAX_LEN - READ_CMD_LEN;
+    return lkbt51_link_send(pkt, i);
+#else
+    return false;
 #endif
 }
 
-void lkbt51_send_keyboard(uint8_t* report) {
+bool lkbt51_send_keyboard(uint8_t* report) {
     uint8_t i = 0;
     memset(payload, 0, PACKET_MAX_LEN);
 
@@ -320,10 +518,10 @@ void lkbt51_send_keyboard(uint8_t* report) {
     memcpy(payload + i, report, 8);
     i += 8;
 
-    lkbt51_send_cmd(payload, i, true, false);
+    return lkbt51_send_cmd(payload, i, true, false);
 }
 
-void lkbt51_send_nkro(uint8_t* report) {
+bool lkbt51_send_nkro(uint8_t* report) {
     uint8_t i = 0;
     memset(payload, 0, PACKET_MAX_LEN);
 
@@ -331,10 +529,10 @@ void lkbt51_send_nkro(uint8_t* report) {
     memcpy(payload + i, report, 20); // NKRO report lenght is limited to 20 bytes
     i += 20;
 
-    lkbt51_send_cmd(payload, i, true, false);
+    return lkbt51_send_cmd(payload, i, true, false);
 }
 
-void lkbt51_send_consumer(uint16_t report) {
+bool lkbt51_send_consumer(uint16_t report) {
     uint8_t i = 0;
     memset(payload, 0, PACKET_MAX_LEN);
 
@@ -343,13 +541,13 @@ void lkbt51_send_consumer(uint16_t report) {
     payload[i++] = ((report) >> 8) & 0xFF;
     i += 4; // QMK doesn't send multiple consumer reports, just skip 2nd and 3rd consumer reports
 
-    lkbt51_send_cmd(payload, i, true, false);
+    return lkbt51_send_cmd(payload, i, true, false);
 }
 
-void lkbt51_send_system(uint16_t report) {
+bool lkbt51_send_system(uint16_t report) {
     uint8_t hid_usage = report & 0xFF;
 
-    if (hid_usage < 0x81 || hid_usage > 0x83) return;
+    if (hid_usage < 0x81 || hid_usage > 0x83) return true;
 
     uint8_t i = 0;
     memset(payload, 0, PACKET_MAX_LEN);
@@ -357,10 +555,10 @@ void lkbt51_send_system(uint16_t report) {
     payload[i++] = LKBT51_CMD_SEND_SYSTEM;
     payload[i++] = 0x01 << (hid_usage - 0x81);
 
-    lkbt51_send_cmd(payload, i, true, false);
+    return lkbt51_send_cmd(payload, i, true, false);
 }
 
-void lkbt51_send_mouse(uint8_t* report) {
+bool lkbt51_send_mouse(uint8_t* report) {
     uint8_t i = 0;
     memset(payload, 0, PACKET_MAX_LEN);
 
@@ -373,7 +571,7 @@ void lkbt51_send_mouse(uint8_t* report) {
     payload[i++] = report[4];                        // V wheel
     payload[i++] = report[5];                        // H wheel
 
-    lkbt51_send_cmd(payload, i, false, false);
+    return lkbt51_send_cmd(payload, i, false, false);
 }
 
 /* Send ack to connection event, wireless module will retry 2 times if no ack received */
@@ -434,10 +632,12 @@ void lkbt51_disconnect(void) {
     payload[i++] = LKBT51_CMD_DISCONNECT;
     payload[i++] = 0; // Sleep mode
 
-    spiSelect(&SPID1);
+    lkbt51_link_acquire();
+    spiSelect(&WT_DRIVER);
     wait_ms(30);
-    // spiUnselect(&SPID1);
+    // spiUnselect(&WT_DRIVER);
     wait_ms(70);
+    lkbt51_link_release();
 
     lkbt51_send_cmd(payload, i, true, false);
 }
@@ -571,13 +771,13 @@ bool lkbt51_read_customize_data(uint8_t* data, uint8_t len) {
     buf[i++] = 0x80;
 
 #if HAL_USE_SPI
-    spiStart(&WT_DRIVER, &spicfg);
+    lkbt51_link_acquire();
     spiSelect(&WT_DRIVER);
     spiExchange(&WT_DRIVER, 20, buf, payload);
     uint16_t state = buf[5] | (buf[6] << 8);
     if (state == 0x9527) spiExchange(&WT_DRIVER, len, data, payload);
     spiUnselect(&WT_DRIVER);
-    spiStop(&WT_DRIVER);
+    lkbt51_link_release();
 #endif
 
     return true;
@@ -594,12 +794,12 @@ void lkbt51_write_customize_data(uint8_t* data, uint8_t len) {
     pkt[i++] = 0x00;
 
 #if HAL_USE_SPI
-    spiStart(&WT_DRIVER, &spicfg);
+    lkbt51_link_acquire();
     spiSelect(&WT_DRIVER);
     spiSend(&WT_DRIVER, i, pkt);
     spiSend(&WT_DRIVER, len, data);
-    spiUnselectI(&WT_DRIVER);
-    spiStop(&WT_DRIVER);
+    spiUnselect(&WT_DRIVER);
+    lkbt51_link_release();
 #endif
 
     i = 0;
@@ -681,10 +881,12 @@ static void ack_handler(uint8_t* data, uint8_t len) {
                 case ACK_SUCCESS:
                     report_buffer_set_retry(0);
                     report_buffer_set_inverval(connection_interval);
+                    report_buffer_set_anchor();
                     break;
                 case ACK_FIFO_HALF_WARNING:
                     report_buffer_set_retry(0);
                     report_buffer_set_inverval(connection_interval + 5);
+                    report_buffer_set_anchor();
                     break;
                 case ACK_FIFO_FULL_ERROR:
                     report_buffer_set_inverval(connection_interval + 10);
@@ -757,9 +959,22 @@ void lkbt51_task(void) {
     static uint8_t len              = 0xff;
     static uint8_t sn               = 0;
 
-    if (readPin(LKBT51_INT_INPUT_PIN) == 0) {
+    osalSysLock();
+    /* The module holds INT low while it has more to send, which raises no further edge */
+    if (!rx_ready && link_state != LINK_RX_PREFIX && link_state != LINK_RX_PACKET && readPin(LKBT51_INT_INPUT_PIN) == 0) {
+        rx_requested = true;
+        lkbt51_link_kick_i();
+    }
+    osalSysUnlock();
+
+    if (rx_ready) {
         uint8_t buf[BUFFER_SIZE] = {0};
-        lkbt51_read(buf, expect_len);
+
+        osalSysLock();
+        memcpy(buf, rx_buf, rx_len);
+        rx_ready = false;
+        lkbt51_link_kick_i();
+        osalSysUnlock();
 
         uint8_t* pbuf = buf + VALID_DATA_START_INDEX;
 
@@ -822,6 +1037,8 @@ void lkbt51_task(void) {
                     interval = (pbuf[8] & 0x7F) * 125;
                 }
 
+                report_buffer_set_connection_interval(interval);
+
                 connection_interval = interval / 1000;
                 if (connection_interval > 7) connection_interval /= 3;
 
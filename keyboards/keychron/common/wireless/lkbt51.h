@@ -96,15 +96,16 @@ typedef struct {
 } __attribute__((packed)) module_param_t;
 
 void lkbt51_init(bool wakeup_from_low_power_mode);
+void lkbt51_stop(void);
 void lkbt51_send_protocol_ver(uint16_t ver);
 
-void lkbt51_send_cmd(uint8_t* payload, uint8_t len, bool ack_enable, bool retry);
+bool lkbt51_send_cmd(uint8_t* payload, uint8_t len, bool ack_enable, bool retry);
 
-void lkbt51_send_keyboard(uint8_t* report);
-void lkbt51_send_nkro(uint8_t* report);
-void lkbt51_send_consumer(uint16_t report);
-void lkbt51_send_system(uint16_t report);
-void lkbt51_send_mouse(uint8_t* report);
+bool lkbt51_send_keyboard(uint8_t* report);
+bool lkbt51_send_nkro(uint8_t* report);
+bool lkbt51_send_consumer(uint16_t report);
+bool lkbt51_send_system(uint16_t report);
+bool lkbt51_send_mouse(uint8_t* report);
 
 void lkbt51_become_discoverable(uint8_t host_idx, void* param);
 void lkbt51_connect(uint8_t hostIndex, uint16_t timeout);
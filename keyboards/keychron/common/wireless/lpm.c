@@ -31,6 +31,7 @@
 #include "indicator.h"
 #include "lpm.h"
 #include "transport.h"
+#include "lkbt51.h"
 #include "battery.h"
 #include "report_buffer.h"
 #include "keychron_common.h"
@@ -125,7 +126,7 @@ bool pre_enter_low_power_mode(pm_t mode) {
     // PWR->CR2 &= ~PWR_CR2_USV; /*PWR_CR2_USV is available on STM32L4x2xx and STM32L4x3xx devices only. */
 #endif
 
-    palEnableLineEvent(LKBT51_INT_INPUT_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+    /* LKBT51_INT_INPUT_PIN is kept armed by the wireless link and wakes the MCU as well */
 #ifdef USB_POWER_SENSE_PIN
     palEnableLineEvent(USB_POWER_SENSE_PIN, PAL_EVENT_MODE_BOTH_EDGES);
 #endif
@@ -161,6 +162,7 @@ bool pre_enter_low_power_mode(pm_t mode) {
     select_all_cols();
 
 #if (HAL_USE_SPI == TRUE)
+    lkbt51_stop();
     palSetLineMode(SPI_SCK_PIN, PAL_MODE_INPUT_PULLDOWN);
     palSetLineMode(SPI_MISO_PIN, PAL_MODE_INPUT_PULLDOWN);
     palSetLineMode(SPI_MOSI_PIN, PAL_MODE_INPUT_PULLDOWN);
@@ -207,7 +209,6 @@ static inline void lpm_wakeup(void) {
         }
     }
 
-    palDisableLineEvent(LKBT51_INT_INPUT_PIN);
 #ifdef P2P4_MODE_SELECT_PIN
     palDisableLineEvent(P2P4_MODE_SELECT_PIN);
 #endif
@@ -237,6 +238,14 @@ static inline void lpm_wakeup(void) {
     matrix_init();
 }
 
+/* Time left until the run mode window closes and lpm_task() may enter low power mode */
+uint32_t lpm_deadline(void) {
+    if (lpm_time_up) return NO_DEADLINE;
+
+    uint32_t elapsed = sync_timer_elapsed32(lpm_timer_buffer);
+    return elapsed > RUN_MODE_PROCESS_TIME ? 0 : RUN_MODE_PROCESS_TIME + 1 - elapsed;
+}
+
 void lpm_task(void) {
     if (!lpm_time_up && sync_timer_elapsed32(lpm_timer_buffer) > RUN_MODE_PROCESS_TIME) {
         lpm_time_up      = true;
@@ -34,3 +34,4 @@ bool usb_power_connected(void);
 bool lpm_is_kb_idle(void);
 void enter_power_mode(pm_t mode);
 void lpm_task(void);
+uint32_t lpm_deadline(void);
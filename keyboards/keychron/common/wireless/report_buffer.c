@@ -20,17 +20,31 @@
 #include "lpm.h"
 
 /* The report buffer is mainly used to fix key press lost issue of macro
- * when wireless module fifo isn't large enough. The maximun macro
- * string length is determined by this queue size, and should be
- * REPORT_BUFFER_QUEUE_SIZE devided by 2 since each character is implemented
- * by sending a key pressing then a key releasing report.
- * Please note that it cosume sizeof(report_buffer_t)  * REPORT_BUFFER_QUEUE_SIZE
- * bytes RAM, with default setting, used RAM size is
- *        sizeof(report_buffer_t) * 256 = 34* 256  =  8704 bytes
+ * when wireless module fifo isn't large enough. Reports are kept in two lanes:
+ *   - key lane: keyboard/NKRO state reports, REPORT_BUFFER_QUEUE_SIZE entries
+ *   - extra lane: consumer/system reports, REPORT_BUFFER_EXTRA_QUEUE_SIZE entries
+ * The extra lane is always drained first so that media keys never wait behind
+ * a long macro.
+ *
+ * The maximun macro string length is determined by the key lane size, and
+ * should be REPORT_BUFFER_QUEUE_SIZE devided by 2 since each character is
+ * implemented by sending a key pressing then a key releasing report.
+ *
+ * A keyboard/NKRO report which repeats the newest state report still waiting in
+ * the key lane is dropped. One which presses more keys is merged into it only if
+ * the queued report itself presses no key, e.g. it just adds a modifier, so two
+ * presses never end up in one report, where the host can't tell their order.
+ * If a lane is full, its newest queued report is overwritten so the host still
+ * gets the final state, and report_buffer_enqueue() returns false since the
+ * overwritten change is lost.
+ *
+ * Please note that it cosume sizeof(report_buffer_t) * REPORT_BUFFER_QUEUE_SIZE
+ * + sizeof(report_buffer_t) * REPORT_BUFFER_EXTRA_QUEUE_SIZE bytes RAM, with
+ * default setting, used RAM size is
+ *        34 * 256 + 34 * 16 = 9248 bytes
  */
-#ifndef REPORT_BUFFER_QUEUE_SIZE
-#    define REPORT_BUFFER_QUEUE_SIZE 256
-#endif
+
+_Static_assert(REPORT_BUFFER_EXTRA_QUEUE_SIZE <= 256, "REPORT_BUFFER_EXTRA_QUEUE_SIZE must fit the uint8_t extra lane indices");
 
 extern wt_func_t wireless_transport;
 
@@ -42,29 +56,112 @@ extern wt_func_t wireless_transport;
  */
 uint8_t report_interval = DEFAULT_2P4G_REPORT_INVERVAL_MS;
 
+/* The wireless module acks a report when it is taken at a connection event, the
+ * ack time is used as the anchor point of the connection interval. Once the anchor
+ * point and the connection interval the module reported are known, a report that
+ * starts a burst is handed to the module REPORT_BUFFER_ANCHOR_LEAD_MS before the
+ * next anchor point, so the freshest state goes out at that connection event. The
+ * rest of the burst follows every report_interval as before.
+ */
+static uint32_t anchor_time            = 0;
+static bool     anchor_valid           = false;
+static uint32_t connection_interval_us = 0;
+
 static uint32_t report_timer_buffer = 0;
 uint32_t        retry_time_buffer   = 0;
 report_buffer_t report_buffer_queue[REPORT_BUFFER_QUEUE_SIZE];
 uint16_t        report_buffer_queue_head;
 uint16_t        report_buffer_queue_tail;
+report_buffer_t report_buffer_extra_queue[REPORT_BUFFER_EXTRA_QUEUE_SIZE];
+uint8_t         report_buffer_extra_queue_head;
+uint8_t         report_buffer_extra_queue_tail;
 report_buffer_t kb_rpt;
 uint8_t         retry = 0;
 
+/* Last key lane report handed to the module, the state the host has before the oldest queued one */
+static report_buffer_t key_rpt_sent;
+
 void report_buffer_task(void);
 
 void report_buffer_init(void) {
     // Initialise the report queue
     memset(&report_buffer_queue, 0, sizeof(report_buffer_queue));
-    report_buffer_queue_head = 0;
-    report_buffer_queue_tail = 0;
-    retry                    = 0;
-    report_timer_buffer      = timer_read32();
+    memset(&report_buffer_extra_queue, 0, sizeof(report_buffer_extra_queue));
+    report_buffer_queue_head       = 0;
+    report_buffer_queue_tail       = 0;
+    report_buffer_extra_queue_head = 0;
+    report_buffer_extra_queue_tail = 0;
+    retry                          = 0;
+    key_rpt_sent.type              = REPORT_TYPE_NONE;
+    anchor_valid                   = false;
+    report_timer_buffer            = timer_read32();
 }
 
-bool report_buffer_enqueue(report_buffer_t *report) {
+/* Check whether every key and modifier of old report is still set in new report */
+static bool report_buffer_is_superset(report_buffer_t *old, report_buffer_t *new) {
+    if (old->type != new->type) return false;
+
+    switch (new->type) {
+        case REPORT_TYPE_KB:
+            if (old->keyboard.mods & ~new->keyboard.mods) return false;
+            for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (old->keyboard.keys[i] == KC_NO) continue;
+
+                uint8_t j = 0;
+                while (j < KEYBOARD_REPORT_KEYS && new->keyboard.keys[j] != old->keyboard.keys[i])
+                    j++;
+                if (j == KEYBOARD_REPORT_KEYS) return false;
+            }
+            return true;
+
+        case REPORT_TYPE_NKRO:
+            if (old->nkro.mods & ~new->nkro.mods) return false;
+            for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+                if (old->nkro.bits[i] & ~new->nkro.bits[i]) return false;
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/* Check whether new report presses a key which isn't held in old report, modifiers aside */
+static bool report_buffer_adds_key(report_buffer_t *old, report_buffer_t *new) {
+    report_buffer_t keys = *new;
+
+    if (keys.type == REPORT_TYPE_KB) {
+        keys.keyboard.mods = 0;
+    } else if (keys.type == REPORT_TYPE_NKRO) {
+        keys.nkro.mods = 0;
+    }
+    return !report_buffer_is_superset(&keys, old);
+}
+
+static bool report_buffer_enqueue_key(report_buffer_t *report) {
     uint16_t next = (report_buffer_queue_head + 1) % REPORT_BUFFER_QUEUE_SIZE;
-    if (next == report_buffer_queue_tail) {
-        return false;
+
+    if (report_buffer_queue_head != report_buffer_queue_tail) {
+        uint16_t         last   = (report_buffer_queue_head + REPORT_BUFFER_QUEUE_SIZE - 1) % REPORT_BUFFER_QUEUE_SIZE;
+        report_buffer_t *latest = &report_buffer_queue[last];
+        report_buffer_t *prev   = last == report_buffer_queue_tail ? &key_rpt_sent : &report_buffer_queue[(last + REPORT_BUFFER_QUEUE_SIZE - 1) % REPORT_BUFFER_QUEUE_SIZE];
+
+        /* Same state again */
+        if (report_buffer_is_superset(latest, report) && report_buffer_is_superset(report, latest)) {
+            return true;
+        }
+
+        /* Coalesce with the newest pending state if that neither releases nor presses a key */
+        if (prev->type != REPORT_TYPE_NONE && report_buffer_is_superset(prev, latest) && !report_buffer_adds_key(prev, latest) && report_buffer_is_superset(latest, report)) {
+            *latest = *report;
+            return true;
+        }
+
+        /* Keep the latest state if the queue is full */
+        if (next == report_buffer_queue_tail) {
+            *latest = *report;
+            return false;
+        }
     }
 
     report_buffer_queue[report_buffer_queue_head] = *report;
@@ -72,26 +169,107 @@ bool report_buffer_enqueue(report_buffer_t *report) {
     return true;
 }
 
+static bool report_buffer_enqueue_extra(report_buffer_t *report) {
+    uint8_t next = (report_buffer_extra_queue_head + 1) % REPORT_BUFFER_EXTRA_QUEUE_SIZE;
+    if (next == report_buffer_extra_queue_tail) {
+        report_buffer_extra_queue[(report_buffer_extra_queue_head + REPORT_BUFFER_EXTRA_QUEUE_SIZE - 1) % REPORT_BUFFER_EXTRA_QUEUE_SIZE] = *report;
+        return false;
+    }
+
+    report_buffer_extra_queue[report_buffer_extra_queue_head] = *report;
+    report_buffer_extra_queue_head                            = next;
+    return true;
+}
+
+bool report_buffer_enqueue(report_buffer_t *report) {
+    switch (report->type) {
+        case REPORT_TYPE_KB:
+        case REPORT_TYPE_NKRO:
+            return report_buffer_enqueue_key(report);
+        case REPORT_TYPE_CONSUMER:
+        case REPORT_TYPE_SYSTEM:
+            return report_buffer_enqueue_extra(report);
+        default:
+            return false;
+    }
+}
+
 inline bool report_buffer_dequeue(report_buffer_t *report) {
+    if (report_buffer_extra_queue_head != report_buffer_extra_queue_tail) {
+        *report                        = report_buffer_extra_queue[report_buffer_extra_queue_tail];
+        report_buffer_extra_queue_tail = (report_buffer_extra_queue_tail + 1) % REPORT_BUFFER_EXTRA_QUEUE_SIZE;
+        return true;
+    }
+
     if (report_buffer_queue_head == report_buffer_queue_tail) {
         return false;
     }
 
     *report                  = report_buffer_queue[report_buffer_queue_tail];
+    key_rpt_sent             = *report;
     report_buffer_queue_tail = (report_buffer_queue_tail + 1) % REPORT_BUFFER_QUEUE_SIZE;
     return true;
 }
 
+bool report_buffer_is_half_full(void) {
+    uint16_t keys  = (report_buffer_queue_head + REPORT_BUFFER_QUEUE_SIZE - report_buffer_queue_tail) % REPORT_BUFFER_QUEUE_SIZE;
+    uint8_t  extra = (report_buffer_extra_queue_head + REPORT_BUFFER_EXTRA_QUEUE_SIZE - report_buffer_extra_queue_tail) % REPORT_BUFFER_EXTRA_QUEUE_SIZE;
+
+    return keys > REPORT_BUFFER_QUEUE_SIZE / 2 || extra > REPORT_BUFFER_EXTRA_QUEUE_SIZE / 2;
+}
+
 bool report_buffer_is_empty() {
-    return report_buffer_queue_head == report_buffer_queue_tail;
+    return report_buffer_queue_head == report_buffer_queue_tail && report_buffer_extra_queue_head == report_buffer_extra_queue_tail;
 }
 
 void report_buffer_update_timer(void) {
     report_timer_buffer = timer_read32();
 }
 
+/* Milliseconds until the send window ahead of the next anchor point opens, 0 while
+ * it is open or when the report doesn't have to wait for it */
+static uint32_t report_buffer_anchor_wait(void) {
+    if (!anchor_valid || connection_interval_us < REPORT_BUFFER_ANCHOR_LEAD_MS * 2000) return 0;
+
+    uint32_t since_anchor = timer_elapsed32(anchor_time);
+    if (since_anchor >= REPORT_BUFFER_ANCHOR_TIMEOUT_MS) {
+        anchor_valid = false;
+        return 0;
+    }
+
+    /* Within a burst the module still has reports to send, don't hold this one back */
+    if (timer_elapsed32(report_timer_buffer) < (connection_interval_us + 999) / 1000) return 0;
+
+    uint32_t phase = (since_anchor * 1000) % connection_interval_us;
+    uint32_t open  = connection_interval_us - REPORT_BUFFER_ANCHOR_LEAD_MS * 1000;
+
+    return phase >= open ? 0 : (open - phase + 999) / 1000;
+}
+
 bool report_buffer_next_inverval(void) {
-    return timer_elapsed32(report_timer_buffer) > report_interval;
+    return timer_elapsed32(report_timer_buffer) > report_interval && report_buffer_anchor_wait() == 0;
+}
+
+/* Time left until report_buffer_task() has a report to hand to the module */
+uint32_t report_buffer_deadline(void) {
+    if (wireless_get_state() != WT_CONNECTED || (report_buffer_is_empty() && !retry)) return NO_DEADLINE;
+
+    if (retry) {
+        uint32_t elapsed = timer_elapsed32(retry_time_buffer);
+        return elapsed > RETPORT_RETRY_INTERVAL_MS ? 0 : RETPORT_RETRY_INTERVAL_MS + 1 - elapsed;
+    }
+
+    uint32_t elapsed = timer_elapsed32(report_timer_buffer);
+    return MAX(elapsed > report_interval ? 0 : report_interval + 1 - elapsed, report_buffer_anchor_wait());
+}
+
+void report_buffer_set_anchor(void) {
+    anchor_time  = timer_read32();
+    anchor_valid = true;
+}
+
+void report_buffer_set_connection_interval(uint32_t interval_us) {
+    connection_interval_us = interval_us;
 }
 
 void report_buffer_set_inverval(uint8_t interval) {
@@ -107,6 +285,24 @@ void report_buffer_set_retry(uint8_t times) {
     retry = times;
 }
 
+/* Hands a report to the module, false if the module link could not take it */
+static bool report_buffer_send(report_buffer_t *report) {
+    switch (report->type) {
+#if defined(NKRO_ENABLE) && defined(WIRELESS_NKRO_ENABLE)
+        case REPORT_TYPE_NKRO:
+            return !wireless_transport.send_nkro || wireless_transport.send_nkro(&report->nkro.mods);
+#endif
+        case REPORT_TYPE_KB:
+            return !wireless_transport.send_keyboard || wireless_transport.send_keyboard(&report->keyboard.mods);
+        case REPORT_TYPE_CONSUMER:
+            return !wireless_transport.send_consumer || wireless_transport.send_consumer(report->consumer);
+        case REPORT_TYPE_SYSTEM:
+            return !wireless_transport.send_system || wireless_transport.send_system(report->system);
+        default:
+            return true;
+    }
+}
+
 void report_buffer_task(void) {
     if (wireless_get_state() == WT_CONNECTED && (!report_buffer_is_empty() || retry) && report_buffer_next_inverval()) {
         bool pending_data = false;
@@ -120,7 +316,7 @@ void report_buffer_task(void) {
                 }
             }
         } else {
-            if (timer_elapsed32(retry_time_buffer) > 2) {
+            if (timer_elapsed32(retry_time_buffer) > RETPORT_RETRY_INTERVAL_MS) {
                 pending_data = true;
                 --retry;
                 retry_time_buffer = timer_read32();
@@ -128,17 +324,15 @@ void report_buffer_task(void) {
         }
 
         if (pending_data) {
-#if defined(NKRO_ENABLE) && defined(WIRELESS_NKRO_ENABLE)
-            if (kb_rpt.type == REPORT_TYPE_NKRO && wireless_transport.send_nkro) {
-                wireless_transport.send_nkro(&kb_rpt.nkro.mods);
-            } else if (kb_rpt.type == REPORT_TYPE_KB && wireless_transport.send_keyboard)
-                wireless_transport.send_keyboard(&kb_rpt.keyboard.mods);
-#else
-            if (kb_rpt.type == REPORT_TYPE_KB && wireless_transport.send_keyboard) wireless_transport.send_keyboard(&kb_rpt.keyboard.mods);
-#endif
-            if (kb_rpt.type == REPORT_TYPE_CONSUMER && wireless_transport.send_consumer) wireless_transport.send_consumer(kb_rpt.consumer);
-            report_timer_buffer = timer_read32();
-            lpm_timer_reset();
+            if (report_buffer_send(&kb_rpt)) {
+                report_timer_buffer = timer_read32();
+                lpm_timer_reset();
+            } else {
+                /* The module link is busy, hand the same report over again on the
+                 * next pass without using up one of its retries */
+                ++retry;
+                retry_time_buffer = timer_read32() - RETPORT_RETRY_INTERVAL_MS - 1;
+            }
         }
     }
 }
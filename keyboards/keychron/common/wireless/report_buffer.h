@@ -33,11 +33,37 @@
 #    define RETPORT_RETRY_COUNT 30
 #endif
 
+/* Minimum time between two retries of the same report */
+#ifndef RETPORT_RETRY_INTERVAL_MS
+#    define RETPORT_RETRY_INTERVAL_MS 2
+#endif
+
+/* How early a report is handed to the module before the next connection event anchor */
+#ifndef REPORT_BUFFER_ANCHOR_LEAD_MS
+#    define REPORT_BUFFER_ANCHOR_LEAD_MS 1
+#endif
+
+/* Anchor point is considered lost if no ack is received within this time */
+#ifndef REPORT_BUFFER_ANCHOR_TIMEOUT_MS
+#    define REPORT_BUFFER_ANCHOR_TIMEOUT_MS 500
+#endif
+
+/* Number of keyboard/NKRO reports the key lane can hold */
+#ifndef REPORT_BUFFER_QUEUE_SIZE
+#    define REPORT_BUFFER_QUEUE_SIZE 256
+#endif
+
+/* Number of consumer/system reports the extra lane can hold */
+#ifndef REPORT_BUFFER_EXTRA_QUEUE_SIZE
+#    define REPORT_BUFFER_EXTRA_QUEUE_SIZE 16
+#endif
+
 enum {
     REPORT_TYPE_NONE,
     REPORT_TYPE_KB,
     REPORT_TYPE_NKRO,
     REPORT_TYPE_CONSUMER,
+    REPORT_TYPE_SYSTEM,
 };
 
 typedef struct {
@@ -46,16 +72,21 @@ typedef struct {
         report_keyboard_t keyboard;
         report_nkro_t     nkro;
         uint16_t          consumer;
+        uint16_t          system;
     };
 } report_buffer_t;
 
-void    report_buffer_init(void);
-bool    report_buffer_enqueue(report_buffer_t *report);
-bool    report_buffer_dequeue(report_buffer_t *report);
-bool    report_buffer_is_empty(void);
-void    report_buffer_update_timer(void);
-bool    report_buffer_next_inverval(void);
-void    report_buffer_set_inverval(uint8_t interval);
-uint8_t report_buffer_get_retry(void);
-void    report_buffer_set_retry(uint8_t times);
-void    report_buffer_task(void);
+void     report_buffer_init(void);
+bool     report_buffer_enqueue(report_buffer_t *report);
+bool     report_buffer_dequeue(report_buffer_t *report);
+bool     report_buffer_is_empty(void);
+bool     report_buffer_is_half_full(void);
+void     report_buffer_update_timer(void);
+bool     report_buffer_next_inverval(void);
+void     report_buffer_set_inverval(uint8_t interval);
+void     report_buffer_set_anchor(void);
+void     report_buffer_set_connection_interval(uint32_t interval_us);
+uint32_t report_buffer_deadline(void);
+uint8_t  report_buffer_get_retry(void);
+void     report_buffer_set_retry(uint8_t times);
+void     report_buffer_task(void);
@@ -344,7 +344,9 @@ void wireless_send_keyboard(report_keyboard_t *report) {
             report_buffer_t report_buffer;
             report_buffer.type = REPORT_TYPE_KB;
             memcpy(&report_buffer.keyboard, report, sizeof(report_keyboard_t));
-            report_buffer_enqueue(&report_buffer);
+            if (!report_buffer_enqueue(&report_buffer)) {
+                kc_printf("report buffer full, latest state kept\n\r");
+            }
 #else
             wireless_transport.send_keyboard(&report->mods);
 #endif
@@ -365,7 +367,9 @@ void wireless_send_nkro(report_nkro_t *report) {
             report_buffer_t report_buffer;
             report_buffer.type = REPORT_TYPE_NKRO;
             memcpy(&report_buffer.nkro, report, sizeof(report_nkro_t));
-            report_buffer_enqueue(&report_buffer);
+            if (!report_buffer_enqueue(&report_buffer)) {
+                kc_printf("report buffer full, latest state kept\n\r");
+            }
 #else
             wireless_transport.send_nkro(&report->mods);
 #endif
@@ -387,7 +391,21 @@ void wireless_send_mouse(report_mouse_t *report) {
 
 void wireless_send_system(uint16_t data) {
     if (wireless_state == WT_CONNECTED) {
+#ifndef DISABLE_REPORT_BUFFER
+        /* Queued instead if the module link can't take it right now */
+        if (report_buffer_is_empty() && report_buffer_next_inverval() && (!wireless_transport.send_system || wireless_transport.send_system(data))) {
+            report_buffer_update_timer();
+        } else {
+            report_buffer_t report_buffer;
+            report_buffer.type   = REPORT_TYPE_SYSTEM;
+            report_buffer.system = data;
+            if (!report_buffer_enqueue(&report_buffer)) {
+                kc_printf("report buffer full, latest state kept\n\r");
+            }
+        }
+#else
         if (wireless_transport.send_system) wireless_transport.send_system(data);
+#endif
     } else if (wireless_state != WT_RESET) {
         wireless_connect();
     }
@@ -396,14 +414,16 @@ void wireless_send_system(uint16_t data) {
 void wireless_send_consumer(uint16_t data) {
     if (wireless_state == WT_CONNECTED) {
 #ifndef DISABLE_REPORT_BUFFER
-        if (report_buffer_is_empty() && report_buffer_next_inverval()) {
-            if (wireless_transport.send_consumer) wireless_transport.send_consumer(data);
+        /* Queued instead if the module link can't take it right now */
+        if (report_buffer_is_empty() && report_buffer_next_inverval() && (!wireless_transport.send_consumer || wireless_transport.send_consumer(data))) {
             report_buffer_update_timer();
         } else {
             report_buffer_t report_buffer;
             report_buffer.type     = REPORT_TYPE_CONSUMER;
             report_buffer.consumer = data;
-            report_buffer_enqueue(&report_buffer);
+            if (!report_buffer_enqueue(&report_buffer)) {
+                kc_printf("report buffer full, latest state kept\n\r");
+            }
         }
 #else
         if (wireless_transport.send_consumer) wireless_transport.send_consumer(data);
@@ -511,6 +531,26 @@ void wireless_task(void) {
     lpm_task();
 }
 
+#ifdef KEYBOARD_IDLE_SLEEP
+uint32_t keyboard_idle_deadline_kb(uint32_t deadline) {
+#    ifndef DISABLE_REPORT_BUFFER
+    deadline = MIN(deadline, report_buffer_deadline());
+#    endif
+    deadline = MIN(deadline, lpm_deadline());
+
+    return keyboard_idle_deadline_user(deadline);
+}
+#endif
+
+#if defined(SEND_STRING_ASYNC) && !defined(DISABLE_REPORT_BUFFER)
+/* Let the module catch up before typing more of a long string */
+bool send_string_async_ready_kb(void) {
+    if ((get_transport() & TRANSPORT_WIRELESS) && report_buffer_is_half_full()) return false;
+
+    return send_string_async_ready_user();
+}
+#endif
+
 void send_string_task(void) {
     if ((get_transport() & TRANSPORT_WIRELESS) && wireless_get_state() == WT_CONNECTED) {
         wireless_transport.task();
@@ -19,13 +19,14 @@
 #include "transport.h"
 #include "factory_test.h"
 #include "keychron_task.h"
+#include "profiling.h"
 
 __attribute__((weak)) void wireless_pre_task(void) {}
 __attribute__((weak)) void wireless_post_task(void) {}
 
 bool wireless_tasks(void) {
     wireless_pre_task();
-    wireless_task();
+    PROFILE_SLOT(PROFILE_WIRELESS_TASK, wireless_task());
     wireless_post_task();
 
     /* usb_remote_wakeup() should be invoked last so that we have chance
@@ -49,6 +49,15 @@ void wait_us(uint16_t duration);
 
 #include "_wait.c"
 
+#ifdef KEYBOARD_IDLE_SLEEP
+extern binary_semaphore_t wait_idle_sem;
+
+/* Sleeps for up to ms milliseconds, returning early once an interrupt has
+ * called wait_idle_wakeup_i(), or straight away if one did since the last wait */
+#    define wait_idle_ms(ms) ((void)chBSemWaitTimeout(&wait_idle_sem, TIME_MS2I(ms)))
+#    define wait_idle_wakeup_i() chBSemSignalI(&wait_idle_sem)
+#endif
+
 /* For GPIOs on ARM-based MCUs, the input pins are sampled by the clock of the bus
  * to which the GPIO is connected.
  * The connected buses differ depending on the various series of MCUs.
@@ -0,0 +1,406 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial_usart.h"
+#include "synchronization_util.h"
+#include "chibios_config.h"
+
+/*
+ * Full-duplex split transport on top of the ChibiOS UART driver, which moves
+ * every transfer with DMA and reports its completion by callback. The
+ * initiator2target buffers are streamed straight out of the split shared
+ * memory, and the initiator can start a transaction and collect its result
+ * later, see soft_serial_transaction_start() and
+ * soft_serial_transaction_finish().
+ *
+ * The target acknowledges the transaction ID only once it has armed the
+ * reception of the initiator2target buffer, and the initiator holds the
+ * buffer back until it has seen that acknowledgment:
+ *
+ *   initiator -> target: transaction ID
+ *   target -> initiator: transaction ID ^ NUM_TOTAL_TRANSACTIONS
+ *   initiator -> target: initiator2target buffer
+ *   target -> initiator: target2initiator buffer
+ *
+ * Without an initiator2target buffer the target answers right behind the
+ * acknowledgment, so the initiator receives both with a single DMA transfer
+ * into a staging buffer and no byte can arrive between two receptions.
+ * Otherwise the target only answers once the buffer the initiator sends after
+ * the acknowledgment has arrived, and the reply reception is armed before that.
+ *
+ * While no receive is running, the UART driver keeps its RX DMA stream in
+ * circular mode and hands every byte to the rxchar callback, which is where
+ * the target picks up the transaction ID.
+ */
+
+#if !HAL_USE_UART || !UART_USE_WAIT
+#    error The usart_dma split transport requires HAL_USE_UART and UART_USE_WAIT to be set to TRUE in halconf.h
+#endif
+
+#if !defined(SERIAL_USART_FULL_DUPLEX)
+#    error The usart_dma split transport only supports full-duplex operation, define SERIAL_USART_FULL_DUPLEX
+#endif
+
+#if !defined(SERIAL_USART_DMA_DRIVER)
+#    define SERIAL_USART_DMA_DRIVER UARTD1
+#endif
+
+typedef enum { SERIAL_DMA_IDLE, SERIAL_DMA_SEND_HANDSHAKE, SERIAL_DMA_RECEIVE_HANDSHAKE, SERIAL_DMA_SEND_BUFFER, SERIAL_DMA_RECEIVE_BUFFER, SERIAL_DMA_PROCESSING, SERIAL_DMA_COMPLETE, SERIAL_DMA_FAILED } serial_dma_state_t;
+
+static void serial_dma_tx_end(UARTDriver* uartp);
+static void serial_dma_rx_end(UARTDriver* uartp);
+static void serial_dma_rx_char(UARTDriver* uartp, uint16_t c);
+static void serial_dma_rx_error(UARTDriver* uartp, uartflags_t e);
+
+/* The callbacks are filled in by serial_dma_start(), a SERIAL_USART_CONFIG only has to describe the peripheral. */
+#if defined(SERIAL_USART_CONFIG)
+static UARTConfig serial_config = SERIAL_USART_CONFIG;
+#elif defined(MCU_STM32) /* STM32 MCUs */
+static UARTConfig serial_config = {
+    .speed = (SERIAL_USART_SPEED),
+    .cr1   = (SERIAL_USART_CR1),
+    .cr2   = (SERIAL_USART_CR2),
+    .cr3   = (SERIAL_USART_CR3),
+};
+#else
+#    error MCU Familiy not supported by default, supply your own serial_config by defining SERIAL_USART_CONFIG in your keyboard files.
+#endif
+
+static UARTDriver* const serial_driver = &SERIAL_USART_DMA_DRIVER;
+
+static bool                        is_initiator = false;
+static volatile serial_dma_state_t state        = SERIAL_DMA_IDLE;
+static thread_reference_t          waiting_thread;
+
+/* Transaction being run, its ID doubles as the buffer for sending the ID. */
+static uint8_t                   transaction_id;
+static split_transaction_desc_t* transaction;
+static uint8_t                   handshake;
+
+/* The initiator receives the acknowledgment into the first byte, and the target2initiator buffer behind it. */
+static uint8_t reply_buffer[1 + UINT8_MAX];
+
+/* ID the initiator sent while the target was still busy with the previous transaction. */
+static int16_t queued_transaction_id = -1;
+
+/* The target stages its buffers here, as the split shared memory may only be touched with the lock held. */
+static uint8_t receive_buffer[UINT8_MAX];
+static uint8_t send_buffer[UINT8_MAX];
+
+/**
+ * @brief Ends the current transaction on the initiator and wakes up the thread waiting for it.
+ */
+static void serial_dma_complete_i(bool success) {
+    state = success ? SERIAL_DMA_COMPLETE : SERIAL_DMA_FAILED;
+    osalThreadResumeI(&waiting_thread, MSG_OK);
+}
+
+/**
+ * @brief Arms the target for the transaction with the given ID and acknowledges it.
+ */
+static void serial_dma_accept_i(UARTDriver* uartp, uint8_t id) {
+    transaction_id = id;
+    transaction    = &split_transaction_table[transaction_id];
+    handshake      = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+
+    /* Reception has to be running before the initiator sees the acknowledgment. */
+    if (transaction->initiator2target_buffer_size) {
+        state = SERIAL_DMA_RECEIVE_BUFFER;
+        uartStartReceiveI(uartp, transaction->initiator2target_buffer_size, receive_buffer);
+    } else {
+        state = SERIAL_DMA_SEND_HANDSHAKE;
+    }
+    uartStartSendI(uartp, sizeof(handshake), &handshake);
+}
+
+/**
+ * @brief Transmission of a buffer was handed to the peripheral.
+ */
+static void serial_dma_tx_end(UARTDriver* uartp) {
+    (void)uartp;
+    osalSysLockFromISR();
+    if (is_initiator) {
+        /* Nothing comes back for a transaction without a target2initiator buffer. */
+        if (state == SERIAL_DMA_SEND_BUFFER) {
+            serial_dma_complete_i(true);
+        }
+    } else if (state == SERIAL_DMA_SEND_HANDSHAKE) {
+        /* The transmitter is free again, the target thread may answer. */
+        state = SERIAL_DMA_PROCESSING;
+        osalThreadResumeI(&waiting_thread, MSG_OK);
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Reception of a buffer started with uartStartReceiveI() has completed.
+ */
+static void serial_dma_rx_end(UARTDriver* uartp) {
+    osalSysLockFromISR();
+    if (is_initiator) {
+        if (state == SERIAL_DMA_RECEIVE_HANDSHAKE) {
+            if (reply_buffer[0] != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)) {
+                serial_dma_complete_i(false);
+            } else if (transaction->initiator2target_buffer_size) {
+                /* The target answers only once it has the buffer, so the reply can't be missed. */
+                if (transaction->target2initiator_buffer_size) {
+                    state = SERIAL_DMA_RECEIVE_BUFFER;
+                    uartStartReceiveI(uartp, transaction->target2initiator_buffer_size, &reply_buffer[1]);
+                } else {
+                    state = SERIAL_DMA_SEND_BUFFER;
+                }
+                /* The target acknowledged the ID, so it is ready for the buffer. */
+                uartStartSendI(uartp, transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction));
+            } else {
+                /* Any reply came in with the acknowledgment. */
+                serial_dma_complete_i(true);
+            }
+        } else if (state == SERIAL_DMA_RECEIVE_BUFFER) {
+            serial_dma_complete_i(true);
+        }
+    } else if (state == SERIAL_DMA_RECEIVE_BUFFER) {
+        /* Let the target thread process the request and answer it. */
+        state = SERIAL_DMA_PROCESSING;
+        osalThreadResumeI(&waiting_thread, MSG_OK);
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief A byte arrived while no reception was running.
+ */
+static void serial_dma_rx_char(UARTDriver* uartp, uint16_t c) {
+    osalSysLockFromISR();
+    if (!is_initiator && (uint8_t)c < NUM_TOTAL_TRANSACTIONS) {
+        if (state == SERIAL_DMA_IDLE) {
+            serial_dma_accept_i(uartp, (uint8_t)c);
+        } else if (state == SERIAL_DMA_PROCESSING) {
+            /* The initiator gave up on the answer, take the new ID once it is sent. */
+            queued_transaction_id = (uint8_t)c;
+        }
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Parity, framing, noise or overrun error, drop the transaction.
+ */
+static void serial_dma_rx_error(UARTDriver* uartp, uartflags_t e) {
+    (void)e;
+    osalSysLockFromISR();
+    if (state == SERIAL_DMA_RECEIVE_HANDSHAKE || state == SERIAL_DMA_RECEIVE_BUFFER) {
+        uartStopReceiveI(uartp);
+        if (is_initiator) {
+            uartStopSendI(uartp);
+            serial_dma_complete_i(false);
+        } else {
+            state = SERIAL_DMA_IDLE;
+        }
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Processes a request received by the target and sends the reply.
+ */
+static inline void react_to_transaction(void) {
+    size_t size = transaction->target2initiator_buffer_size;
+
+    /* Stage the reply, so the lock is not held across the blocking send. */
+    {
+        split_shared_memory_lock_autounlock();
+
+        if (transaction->initiator2target_buffer_size) {
+            memcpy(split_trans_initiator2target_buffer(transaction), receive_buffer, transaction->initiator2target_buffer_size);
+        }
+
+        /* Allow any slave processing to occur. */
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+
+        if (size) {
+            memcpy(send_buffer, split_trans_target2initiator_buffer(transaction), size);
+        }
+    }
+
+    /* Send transaction buffer to the master. If this transaction requires it. */
+    if (size) {
+        uartSendFullTimeout(serial_driver, &size, send_buffer, TIME_MS2I(SERIAL_USART_TIMEOUT));
+    }
+}
+
+/**
+ * @brief This thread runs on the slave and answers the transactions picked up by the UART callbacks.
+ */
+static THD_WORKING_AREA(waSlaveThread, 1024);
+static THD_FUNCTION(SlaveThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_tx_rx");
+
+    bool receive_stalled = false;
+    while (true) {
+        osalSysLock();
+        msg_t msg = osalThreadSuspendTimeoutS(&waiting_thread, TIME_MS2I(SERIAL_USART_TIMEOUT));
+        if (msg == MSG_TIMEOUT) {
+            /* Give up on a buffer that stopped arriving half-way, e.g. because the master was reset. */
+            if (state == SERIAL_DMA_RECEIVE_BUFFER && receive_stalled) {
+                uartStopReceiveI(serial_driver);
+                state = SERIAL_DMA_IDLE;
+            }
+            receive_stalled = (state == SERIAL_DMA_RECEIVE_BUFFER);
+            osalSysUnlock();
+            continue;
+        }
+        osalSysUnlock();
+
+        react_to_transaction();
+        receive_stalled = false;
+
+        osalSysLock();
+        state = SERIAL_DMA_IDLE;
+        if (queued_transaction_id >= 0) {
+            serial_dma_accept_i(serial_driver, (uint8_t)queued_transaction_id);
+            queued_transaction_id = -1;
+        }
+        osalSysUnlock();
+    }
+}
+
+/**
+ * @brief Initiate pins for USART peripheral. Full-duplex configuration.
+ */
+__attribute__((weak)) void usart_init(void) {
+#if defined(MCU_STM32) /* STM32 MCUs */
+#    if defined(USE_GPIOV1)
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE_PUSHPULL);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_INPUT);
+#    else
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_TX_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL | PAL_OUTPUT_SPEED_HIGHEST);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_RX_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL | PAL_OUTPUT_SPEED_HIGHEST);
+#    endif
+
+#    if defined(USART_REMAP)
+    USART_REMAP;
+#    endif
+#else
+#    pragma message "usart_init: MCU Familiy not supported by default, please supply your own init code by implementing usart_init() in your keyboard files."
+#endif
+}
+
+/**
+ * @brief Hooks the transport into the UART driver and starts it.
+ */
+static void serial_dma_start(void) {
+    serial_config.txend1_cb = serial_dma_tx_end;
+    serial_config.rxend_cb  = serial_dma_rx_end;
+    serial_config.rxchar_cb = serial_dma_rx_char;
+    serial_config.rxerr_cb  = serial_dma_rx_error;
+
+    uartStart(serial_driver, &serial_config);
+}
+
+/**
+ * @brief Slave specific initializations.
+ */
+void soft_serial_target_init(void) {
+    usart_init();
+    serial_dma_start();
+
+    /* Start transport thread. */
+    chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
+}
+
+/**
+ * @brief Master specific initializations.
+ */
+void soft_serial_initiator_init(void) {
+    is_initiator = true;
+    usart_init();
+
+#if defined(MCU_STM32) && defined(SERIAL_USART_PIN_SWAP)
+    serial_config.cr2 |= USART_CR2_SWAP; // master has swapped TX/RX pins
+#endif
+
+    serial_dma_start();
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to complete.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates whether the transaction was started.
+ */
+bool soft_serial_transaction_start(int index) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (unlikely(index >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    osalSysLock();
+    if (unlikely(state != SERIAL_DMA_IDLE)) {
+        osalSysUnlock();
+        serial_dprintf("SPLIT: previous transaction still in flight\n");
+        return false;
+    }
+
+    transaction_id = (uint8_t)index;
+    transaction    = &split_transaction_table[index];
+    state          = SERIAL_DMA_RECEIVE_HANDSHAKE;
+
+    /* Arm the reception of the acknowledgment before the slave can possibly send it,
+     * together with the reply that follows it when there is no buffer to send. */
+    size_t reply_size = 1;
+    if (!transaction->initiator2target_buffer_size) {
+        reply_size += transaction->target2initiator_buffer_size;
+    }
+    uartStartReceiveI(serial_driver, reply_size, reply_buffer);
+    uartStartSendI(serial_driver, sizeof(transaction_id), &transaction_id);
+    osalSysUnlock();
+
+    return true;
+}
+
+/**
+ * @brief Wait for the transaction started by soft_serial_transaction_start().
+ *
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction_finish(void) {
+    osalSysLock();
+    if (state == SERIAL_DMA_RECEIVE_HANDSHAKE || state == SERIAL_DMA_SEND_BUFFER || state == SERIAL_DMA_RECEIVE_BUFFER) {
+        if (osalThreadSuspendTimeoutS(&waiting_thread, TIME_MS2I(SERIAL_USART_TIMEOUT)) == MSG_TIMEOUT) {
+            serial_dprintf("SPLIT: transaction timed out\n");
+            uartStopSendI(serial_driver);
+            uartStopReceiveI(serial_driver);
+            state = SERIAL_DMA_FAILED;
+        }
+    }
+
+    bool success = state == SERIAL_DMA_COMPLETE;
+    state        = SERIAL_DMA_IDLE;
+    osalSysUnlock();
+
+    if (success && transaction->target2initiator_buffer_size) {
+        memcpy(split_trans_target2initiator_buffer(transaction), &reply_buffer[1], transaction->target2initiator_buffer_size);
+    }
+
+    return success;
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    if (!soft_serial_transaction_start(index)) {
+        return false;
+    }
+    return soft_serial_transaction_finish();
+}
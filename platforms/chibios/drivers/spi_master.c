@@ -26,11 +26,16 @@ static pin_t currentSlavePin;
 
 static SPIConfig spiConfig;
 
+__attribute__((weak)) void spi_bus_acquire_kb(void) {}
+__attribute__((weak)) void spi_bus_release_kb(void) {}
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
         is_initialised = true;
 
+        spi_bus_acquire_kb();
+
         // Try releasing special pins for a short time
         setPinInput(SPI_SCK_PIN);
         if (SPI_MOSI_PIN != NO_PIN) {
@@ -60,6 +65,8 @@ __attribute__((weak)) void spi_init(void) {
 #endif
         spiStop(&SPI_DRIVER);
         spiStarted = false;
+
+        spi_bus_release_kb();
     }
 }
 
@@ -264,6 +271,9 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     }
 #endif
 
+    /* Only take the bus once nothing can fail, spi_stop() is what gives it back */
+    spi_bus_acquire_kb();
+
     spiStarted = true;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
     currentSlavePin = slavePin;
@@ -315,6 +325,33 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    /* One transfer at a time, on a bus taken with spi_start() */
+    if (!spiStarted || SPI_DRIVER.state != SPI_READY) {
+        return SPI_STATUS_ERROR;
+    }
+
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+bool spi_transmit_done(void) {
+    return SPI_DRIVER.state != SPI_ACTIVE;
+}
+
+spi_status_t spi_transmit_wait(uint16_t timeout) {
+    msg_t msg = MSG_OK;
+
+    /* The DMA end interrupt resumes the thread waiting on the driver, as for spiSend() */
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        msg = osalThreadSuspendTimeoutS(&SPI_DRIVER.thread, timeout == SPI_TIMEOUT_INFINITE ? TIME_INFINITE : TIME_MS2I(timeout));
+    }
+    osalSysUnlock();
+
+    return msg == MSG_TIMEOUT ? SPI_STATUS_TIMEOUT : SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
     if (spiStarted) {
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
@@ -325,5 +362,7 @@ void spi_stop(void) {
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         spiStarted = false;
+
+        spi_bus_release_kb();
     }
 }
@@ -87,7 +87,17 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+bool spi_transmit_done(void);
+
+spi_status_t spi_transmit_wait(uint16_t timeout);
+
 void spi_stop(void);
+
+void spi_bus_acquire_kb(void);
+
+void spi_bus_release_kb(void);
 #ifdef __cplusplus
 }
 #endif
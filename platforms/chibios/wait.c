@@ -19,6 +19,10 @@
 
 #include "_wait.h"
 
+#ifdef KEYBOARD_IDLE_SLEEP
+BSEMAPHORE_DECL(wait_idle_sem, true);
+#endif
+
 #ifdef WAIT_US_TIMER
 void wait_us(uint16_t duration) {
     static const GPTConfig gpt_cfg = {.frequency = 1000000}; /* 1MHz timer, no callback */
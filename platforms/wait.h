@@ -25,6 +25,12 @@ extern "C" {
 #    include_next "_wait.h" /* Include the platforms _wait.h */
 #endif
 
+#if !defined(wait_idle_ms)
+/* Platforms that cannot be woken early simply sleep the whole period */
+#    define wait_idle_ms(ms) wait_ms(ms)
+#    define wait_idle_wakeup_i()
+#endif
+
 #ifdef __cplusplus
 }
 #endif
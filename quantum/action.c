@@ -66,6 +66,30 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
 }
 #endif
 
+/** \brief Checks whether a tick event has anything to do
+ *
+ * Ticks only move the tapping state machine along and expire one-shot state,
+ * so they can be skipped while neither of those is in flight.
+ */
+bool action_tick_pending(void) {
+#ifndef NO_ACTION_TAPPING
+    if (action_tapping_deadline() != NO_DEADLINE) {
+        return true;
+    }
+#endif
+#ifndef NO_ACTION_ONESHOT
+    if (get_oneshot_mods() || is_oneshot_layer_active()) {
+        return true;
+    }
+#    if defined(SWAP_HANDS_ENABLE) && defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0)
+    if (has_oneshot_swaphands_timed_out()) {
+        return true;
+    }
+#    endif
+#endif
+    return false;
+}
+
 /** \brief Called to execute an action.
  *
  * FIXME: Needs documentation.
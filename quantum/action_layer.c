@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch find layer
  *
- * Gets the layer based on key info
+ * Walks the given layers from the top for the first non-transparent action of the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_find_layer(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +337,49 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+
+#    ifdef LAYER_RESOLUTION_CACHE
+#        define LAYER_RESOLUTION_UNKNOWN 0xFF
+
+/* Topmost non-transparent layer of each key, only valid for layer_resolution_state */
+static uint8_t       layer_resolution_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_resolution_state = 0;
+static bool          layer_resolution_valid = false;
+
+/** \brief Layer resolution cache clear
+ *
+ * Drops every resolved layer, they are looked up again on the next press
+ */
+void layer_resolution_cache_clear(void) {
+    layer_resolution_valid = false;
+}
+#    endif
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_RESOLUTION_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        // The layer states are also written directly (split sync, eeconfig), so compare instead of hooking the setters
+        if (!layer_resolution_valid || layer_resolution_state != layers) {
+            memset(layer_resolution_cache, LAYER_RESOLUTION_UNKNOWN, sizeof(layer_resolution_cache));
+            layer_resolution_state = layers;
+            layer_resolution_valid = true;
+        }
+        uint8_t *layer = &layer_resolution_cache[key.row][key.col];
+        if (*layer == LAYER_RESOLUTION_UNKNOWN) {
+            *layer = layer_switch_find_layer(layers, key);
+        }
+        return *layer;
+    }
+#    endif
+    return layer_switch_find_layer(layers, key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -166,5 +166,12 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+#if defined(LAYER_RESOLUTION_CACHE) && !defined(NO_ACTION_LAYER)
+/* forget the resolved layer of every key, call whenever the keymap contents change */
+void layer_resolution_cache_clear(void);
+#else
+#    define layer_resolution_cache_clear()
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
@@ -112,6 +112,21 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Time left until the pending tap key runs out of tapping term
+ *
+ * Returns NO_DEADLINE while no tap key is being tracked, in which case tick
+ * events have nothing to resolve.
+ */
+uint32_t action_tapping_deadline(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return NO_DEADLINE;
+    }
+
+    const uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    const uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    return elapsed < term ? term - elapsed : 0;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <timer.h>
 #include <deferred_exec.h>
+#include <keyboard.h>
+#include <util.h>
 
 #ifndef MAX_DEFERRED_EXECUTORS
 #    define MAX_DEFERRED_EXECUTORS 8
@@ -150,6 +152,26 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+uint32_t deferred_exec_advanced_deadline(deferred_executor_t *table, size_t table_count) {
+    uint32_t now      = timer_read32();
+    uint32_t deadline = NO_DEADLINE;
+
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token == INVALID_DEFERRED_TOKEN) {
+            continue;
+        }
+
+        int32_t remaining = (int32_t)TIMER_DIFF_32(entry->trigger_time, now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        deadline = MIN(deadline, (uint32_t)remaining);
+    }
+
+    return deadline;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -169,3 +191,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+uint32_t deferred_exec_deadline(void) {
+    return deferred_exec_advanced_deadline(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
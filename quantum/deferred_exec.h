@@ -65,6 +65,13 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Forward declaration for the main loop in order to find out how long it may sleep before a deferred executor is due.
+ *
+ * @return the number of milliseconds until the next deferred executor triggers, or NO_DEADLINE if none are scheduled
+ */
+uint32_t deferred_exec_deadline(void);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -119,3 +126,12 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Finds how long until the next executor in a custom table triggers.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @return the number of milliseconds until the next deferred executor triggers, or NO_DEADLINE if none are scheduled
+ */
+uint32_t deferred_exec_advanced_deadline(deferred_executor_t *table, size_t table_count);
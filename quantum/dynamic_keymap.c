@@ -17,10 +17,12 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -101,6 +103,33 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_MACRO_INDEX
+#    ifndef DYNAMIC_KEYMAP_MACRO_READ_SIZE
+#        define DYNAMIC_KEYMAP_MACRO_READ_SIZE 32
+#    endif
+#    define DYNAMIC_KEYMAP_MACRO_NONE UINT16_MAX
+#endif
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Native endian copy of the keymap held in EEPROM, so key lookups are a plain
+// array read. Loaded on first use and written through by every setter below,
+// the EEPROM image stays the persistent copy.
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+static bool     dynamic_keymap_cache_valid = false;
+
+static void dynamic_keymap_cache_load(void) {
+    uint16_t *keycodes = &dynamic_keymap_cache[0][0][0];
+    uint8_t * bytes    = (uint8_t *)dynamic_keymap_cache;
+
+    eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+    // Convert in place, each keycode only depends on the two bytes it overwrites
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS; i++) {
+        keycodes[i] = (bytes[i * 2] << 8) | bytes[i * 2 + 1];
+    }
+    dynamic_keymap_cache_valid = true;
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -112,11 +141,18 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (!dynamic_keymap_cache_valid) {
+        dynamic_keymap_cache_load();
+    }
+    return dynamic_keymap_cache[layer][row][column];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
@@ -125,6 +161,12 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (dynamic_keymap_cache_valid) {
+        dynamic_keymap_cache[layer][row][column] = keycode;
+    }
+#endif
+    layer_resolution_cache_clear();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -171,9 +213,20 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
     void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (!dynamic_keymap_cache_valid) {
+        dynamic_keymap_cache_load();
+    }
+#endif
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            // Serve the big endian EEPROM layout out of the native endian cache
+            uint16_t keycode = (&dynamic_keymap_cache[0][0][0])[(offset + i) / 2];
+            *target          = (offset + i) & 1 ? keycode & 0xFF : keycode >> 8;
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -189,10 +242,17 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
             eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            if (dynamic_keymap_cache_valid) {
+                uint16_t *keycode = &(&dynamic_keymap_cache[0][0][0])[(offset + i) / 2];
+                *keycode          = (offset + i) & 1 ? (*keycode & 0xFF00) | *source : (*keycode & 0x00FF) | (*source << 8);
+            }
+#endif
         }
         source++;
         target++;
     }
+    layer_resolution_cache_clear();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -219,6 +279,57 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
     return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
 }
 
+#ifdef DYNAMIC_KEYMAP_MACRO_INDEX
+// Start of each macro within the macro buffer, rebuilt on the first send after
+// the buffer was written. Macros are then played from a window of the buffer
+// fetched with a single block read, instead of one EEPROM access per byte.
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     dynamic_keymap_macro_terminated  = false;
+static bool     dynamic_keymap_macro_index_valid = false;
+static uint8_t  dynamic_keymap_macro_window[DYNAMIC_KEYMAP_MACRO_READ_SIZE];
+static uint16_t dynamic_keymap_macro_window_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+
+static uint8_t dynamic_keymap_macro_read_byte(uint16_t offset) {
+    if (dynamic_keymap_macro_window_offset == DYNAMIC_KEYMAP_MACRO_NONE || offset < dynamic_keymap_macro_window_offset || offset - dynamic_keymap_macro_window_offset >= DYNAMIC_KEYMAP_MACRO_READ_SIZE) {
+        dynamic_keymap_macro_window_offset = offset - (offset % DYNAMIC_KEYMAP_MACRO_READ_SIZE);
+        uint16_t size                      = MIN(DYNAMIC_KEYMAP_MACRO_READ_SIZE, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - dynamic_keymap_macro_window_offset);
+        eeprom_read_block(dynamic_keymap_macro_window, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + dynamic_keymap_macro_window_offset), size);
+    }
+    return dynamic_keymap_macro_window[offset - dynamic_keymap_macro_window_offset];
+}
+
+static void dynamic_keymap_macro_index_build(void) {
+    uint16_t offset = 0;
+    for (uint8_t id = 0; id < DYNAMIC_KEYMAP_MACRO_COUNT; id++) {
+        if (offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+            dynamic_keymap_macro_offsets[id] = DYNAMIC_KEYMAP_MACRO_NONE;
+            continue;
+        }
+        dynamic_keymap_macro_offsets[id] = offset;
+        // Skip past the null terminator of this macro
+        while (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && dynamic_keymap_macro_read_byte(offset) != 0) {
+            offset++;
+        }
+        offset++;
+    }
+    dynamic_keymap_macro_terminated  = dynamic_keymap_macro_read_byte(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1) == 0;
+    dynamic_keymap_macro_index_valid = true;
+}
+
+static void dynamic_keymap_macro_index_clear(void) {
+    dynamic_keymap_macro_index_valid   = false;
+    dynamic_keymap_macro_window_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+}
+
+static uint8_t dynamic_keymap_macro_fetch(const void *address) {
+    return dynamic_keymap_macro_read_byte((uintptr_t)address - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+}
+#else
+static uint8_t dynamic_keymap_macro_fetch(const void *address) {
+    return eeprom_read_byte(address);
+}
+#endif // DYNAMIC_KEYMAP_MACRO_INDEX
+
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
@@ -243,6 +354,9 @@ void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *da
         source++;
         target++;
     }
+#ifdef DYNAMIC_KEYMAP_MACRO_INDEX
+    dynamic_keymap_macro_index_clear();
+#endif
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -252,13 +366,32 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+#ifdef DYNAMIC_KEYMAP_MACRO_INDEX
+    dynamic_keymap_macro_index_clear();
+#endif
 }
 
+#ifdef SEND_STRING_ASYNC
+static char dynamic_keymap_macro_read(const char *address) {
+    return dynamic_keymap_macro_fetch(address);
+}
+#endif
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
     }
 
+#ifdef DYNAMIC_KEYMAP_MACRO_INDEX
+    if (!dynamic_keymap_macro_index_valid) {
+        dynamic_keymap_macro_index_build();
+    }
+    // An unterminated buffer is being written, possibly an aborted write. So do nothing.
+    if (!dynamic_keymap_macro_terminated || dynamic_keymap_macro_offsets[id] == DYNAMIC_KEYMAP_MACRO_NONE) {
+        return;
+    }
+    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + dynamic_keymap_macro_offsets[id]);
+#else
     // Check the last byte of the buffer.
     // If it's not zero, then we are in the middle
     // of buffer writing, possibly an aborted buffer
@@ -283,13 +416,18 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         ++p;
     }
+#endif
 
+#ifdef SEND_STRING_ASYNC
+    // Played from the main loop straight out of EEPROM, the player stops at a truncated code
+    send_string_async_with_reader((const char *)p, DYNAMIC_KEYMAP_MACRO_DELAY, dynamic_keymap_macro_read);
+#else
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_macro_fetch(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +435,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_macro_fetch(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_macro_fetch(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +454,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_macro_fetch(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
@@ -337,4 +475,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
@@ -33,6 +33,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_tapping.h"
+#include "profiling.h"
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -108,9 +110,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+#    include "send_string.h"
+#endif
 #ifdef VIRTSER_ENABLE
 #    include "virtser.h"
 #endif
@@ -135,6 +143,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifdef KEYBOARD_IDLE_SLEEP
+#    include "wait.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -370,6 +384,79 @@ void housekeeping_task(void) {
     housekeeping_task_user();
 }
 
+#ifdef KEYBOARD_IDLE_SLEEP
+/** \brief keyboard_idle_deadline_user
+ *
+ * Override this function if you have timed work of your own that must not be slept through.
+ */
+__attribute__((weak)) uint32_t keyboard_idle_deadline_user(uint32_t deadline) {
+    return deadline;
+}
+
+/** \brief keyboard_idle_deadline_kb
+ *
+ * Override this function if you have timed work of your own that must not be slept through.
+ */
+__attribute__((weak)) uint32_t keyboard_idle_deadline_kb(uint32_t deadline) {
+    return keyboard_idle_deadline_user(deadline);
+}
+
+/** \brief keyboard_idle_deadline
+ *
+ * Collects the next deadline of every timed subsystem and returns how many
+ * milliseconds the main loop may sleep, capped at KEYBOARD_IDLE_SLEEP_MAX so
+ * the matrix keeps being scanned.
+ */
+uint32_t keyboard_idle_deadline(void) {
+    uint32_t deadline = KEYBOARD_IDLE_SLEEP_MAX;
+
+#    ifndef NO_ACTION_TAPPING
+    deadline = MIN(deadline, action_tapping_deadline());
+#    endif
+#    ifdef COMBO_ENABLE
+    deadline = MIN(deadline, combo_deadline());
+#    endif
+#    ifdef TAP_DANCE_ENABLE
+    deadline = MIN(deadline, tap_dance_deadline());
+#    endif
+#    ifdef DEFERRED_EXEC_ENABLE
+    deadline = MIN(deadline, deferred_exec_deadline());
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    deadline = MIN(deadline, led_matrix_deadline());
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    deadline = MIN(deadline, rgb_matrix_deadline());
+#    endif
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    deadline = MIN(deadline, send_string_async_deadline());
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+    deadline = MIN(deadline, mousekey_deadline());
+#    endif
+
+    return keyboard_idle_deadline_kb(deadline);
+}
+
+/** \brief keyboard_idle_sleep
+ *
+ * Puts the main loop to sleep until the earliest deadline, letting the MCU idle
+ * instead of spinning through passes that have nothing to do. Held keys do not
+ * keep it awake, only timed work does. The sleep ends early when an interrupt
+ * (e.g. USB) hands the main loop work.
+ */
+void keyboard_idle_sleep(void) {
+    /* Input that changed within this tick may still be settling */
+    if (last_input_activity_elapsed() == 0) {
+        return;
+    }
+    uint32_t deadline = keyboard_idle_deadline();
+    if (deadline > 0) {
+        wait_idle_ms(deadline);
+    }
+}
+#endif
+
 /** \brief Init tasks previously located in matrix_init_quantum
  *
  * TODO: rationalise against keyboard_init and current split role
@@ -483,13 +570,19 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
- * internal QMK state machine.
+ * internal QMK state machine. With KEYBOARD_IDLE_SLEEP, ticks are skipped
+ * while the state machine has nothing waiting on time to pass.
  */
 static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
+#ifdef KEYBOARD_IDLE_SLEEP
+        if (action_tick_pending())
+#endif
+        {
+            action_exec(MAKE_TICK_EVENT);
+        }
         last_tick = now;
     }
 }
@@ -509,7 +602,7 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
-    matrix_scan();
+    PROFILE_SLOT(PROFILE_MATRIX_SCAN, matrix_scan());
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -543,7 +636,7 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    PROFILE_SLOT(PROFILE_PROCESS_RECORD, action_exec(MAKE_KEYEVENT(row, col, key_pressed)));
                 }
 
                 switch_events(row, col, key_pressed);
@@ -629,6 +722,10 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    send_string_async_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -710,7 +807,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    PROFILE_SLOT(PROFILE_WIRELESS_TASK, bluetooth_task());
 #endif
 
 #ifdef HAPTIC_ENABLE
@@ -718,4 +815,11 @@ void keyboard_task(void) {
 #endif
 
     led_task();
+
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+    // Flash writes and erases stall the MCU, so wait for a pause in typing
+    if (last_input_activity_elapsed() >= WEAR_LEVELING_WRITE_BACK_IDLE_TIME) {
+        wear_leveling_task();
+    }
+#endif
 }
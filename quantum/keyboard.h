@@ -112,6 +112,22 @@ void housekeeping_task(void);      // To be executed by the main loop in each ba
 void housekeeping_task_kb(void);   // To be overridden by keyboard-level code
 void housekeeping_task_user(void); // To be overridden by user/keymap-level code
 
+/* Returned by the *_deadline() functions when a task has no timed work pending */
+#define NO_DEADLINE UINT32_MAX
+
+#ifdef KEYBOARD_IDLE_SLEEP
+/* Longest the main loop sleeps between two passes, in milliseconds. This is the matrix scan
+ * interval while nothing is due, and so the most latency it adds to a press or release. */
+#    ifndef KEYBOARD_IDLE_SLEEP_MAX
+#        define KEYBOARD_IDLE_SLEEP_MAX 5
+#    endif
+
+uint32_t keyboard_idle_deadline(void);                   // Milliseconds the main loop may sleep before a task needs to run
+uint32_t keyboard_idle_deadline_kb(uint32_t deadline);   // To be overridden by keyboard-level code
+uint32_t keyboard_idle_deadline_user(uint32_t deadline); // To be overridden by user/keymap-level code
+void     keyboard_idle_sleep(void);                      // To be executed by the main loop after each pass
+#endif
+
 uint32_t last_input_activity_time(void);    // Timestamp of the last matrix or encoder or pointing device activity
 uint32_t last_input_activity_elapsed(void); // Number of milliseconds since the last matrix or encoder or pointing device activity
 
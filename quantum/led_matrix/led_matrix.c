@@ -88,7 +88,10 @@ static uint32_t led_matrix_timeout = LED_MATRIX_TIMEOUT;
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+// last_hit_buffer is kept as a ring starting at last_hit_start, it is
+// unrolled into g_last_hit_tracker once per frame.
 static last_hit_t last_hit_buffer;
+static uint8_t    last_hit_start = 0;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // split led matrix
@@ -182,16 +185,13 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
+        // overwrite the oldest hit once the ring is full
+        if (last_hit_buffer.count == LED_HITS_TO_REMEMBER) {
+            last_hit_start = (last_hit_start + 1) % LED_HITS_TO_REMEMBER;
+            last_hit_buffer.count--;
+        }
+        uint8_t index                = (last_hit_start + last_hit_buffer.count) % LED_HITS_TO_REMEMBER;
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
@@ -246,12 +246,16 @@ static void led_task_timers(void) {
     // Update double buffer last hit timers
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     uint8_t count = last_hit_buffer.count;
+    uint8_t start = last_hit_start;
     for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
+        uint8_t index = (start + i) % LED_HITS_TO_REMEMBER;
+        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[index]) {
+            // hits are ordered oldest first, so only the oldest ones can expire
+            last_hit_start = (last_hit_start + 1) % LED_HITS_TO_REMEMBER;
             last_hit_buffer.count--;
             continue;
         }
-        last_hit_buffer.tick[i] += deltaTime;
+        last_hit_buffer.tick[index] += deltaTime;
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -269,7 +273,14 @@ static void led_task_start(void) {
     // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        uint8_t index               = (last_hit_start + i) % LED_HITS_TO_REMEMBER;
+        g_last_hit_tracker.x[i]     = last_hit_buffer.x[index];
+        g_last_hit_tracker.y[i]     = last_hit_buffer.y[index];
+        g_last_hit_tracker.index[i] = last_hit_buffer.index[index];
+        g_last_hit_tracker.tick[i]  = last_hit_buffer.tick[index];
+    }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -389,6 +400,14 @@ void led_matrix_task(void) {
     }
 }
 
+/** \brief Time left until led_matrix_task() has a frame to work on */
+uint32_t led_matrix_deadline(void) {
+    if (led_task_state != SYNCING) return 0;
+
+    uint32_t elapsed = sync_timer_elapsed32(g_led_timer);
+    return elapsed >= LED_MATRIX_LED_FLUSH_LIMIT ? 0 : LED_MATRIX_LED_FLUSH_LIMIT - elapsed;
+}
+
 void led_matrix_indicators(void) {
     led_matrix_indicators_kb();
 }
@@ -459,6 +478,7 @@ void led_matrix_init(void) {
     }
 
     last_hit_buffer.count = 0;
+    last_hit_start        = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         last_hit_buffer.tick[i] = UINT16_MAX;
     }
@@ -150,7 +150,8 @@ void led_matrix_set_value_all(uint8_t value);
 
 void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
-void led_matrix_task(void);
+void     led_matrix_task(void);
+uint32_t led_matrix_deadline(void);
 
 void led_matrix_none_indicators_kb(void);
 void led_matrix_none_indicators_user(void);
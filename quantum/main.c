@@ -72,5 +72,9 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef KEYBOARD_IDLE_SLEEP
+        keyboard_idle_sleep();
+#endif
     }
 }
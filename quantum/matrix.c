@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "matrix.h"
 #include "debounce.h"
+#include "profiling.h"
 #include "atomic_util.h"
 
 #ifdef SPLIT_KEYBOARD
@@ -340,9 +341,10 @@ uint8_t matrix_scan(void) {
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    PROFILE_SLOT(PROFILE_DEBOUNCE, changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed));
+    changed |= matrix_post_scan();
 #else
-    changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    PROFILE_SLOT(PROFILE_DEBOUNCE, changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed));
     matrix_scan_kb();
 #endif
     return (uint8_t)changed;
@@ -22,6 +22,7 @@
 #include "timer.h"
 #include "print.h"
 #include "debug.h"
+#include "keyboard.h"
 #include "mousekey.h"
 
 static inline int8_t times_inv_sqrt2(int8_t x) {
@@ -678,3 +679,13 @@ report_mouse_t mousekey_get_report(void) {
 bool should_mousekey_report_send(report_mouse_t *mouse_report) {
     return mouse_report->x || mouse_report->y || mouse_report->v || mouse_report->h;
 }
+
+/* Held movement and wheel keys are repeated by mousekey_task() */
+uint32_t mousekey_deadline(void) {
+#ifdef MOUSEKEY_INERTIA
+    if (mousekey_frame || mousekey_x_inertia || mousekey_y_inertia) {
+        return 0;
+    }
+#endif
+    return should_mousekey_report_send(&mouse_report) ? 0 : NO_DEADLINE;
+}
@@ -192,6 +192,7 @@ void           mousekey_clear(void);
 void           mousekey_send(void);
 report_mouse_t mousekey_get_report(void);
 bool           should_mousekey_report_send(report_mouse_t *mouse_report);
+uint32_t       mousekey_deadline(void);
 
 #ifdef __cplusplus
 }
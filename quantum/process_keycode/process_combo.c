@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -94,6 +95,22 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Key to combo index, sorted by keycode then by combo index, so that
+ * process_combo() only has to look at the combos the key is part of. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_index_t;
+static combo_key_index_t combo_key_index[COMBO_KEY_INDEX_LENGTH];
+static uint16_t          combo_key_index_size  = 0;
+static uint16_t          combo_key_index_count = 0;
+static bool              combo_key_index_built = false;
+static bool              combo_key_index_valid = false;
+/* Combos whose state may need to be reset by clear_combos(). */
+static uint8_t combo_dirty[(COMBO_KEY_INDEX_LENGTH + 7) / 8];
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -191,9 +208,80 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+static void build_combo_key_index(void) {
+    combo_key_index_size  = 0;
+    combo_key_index_count = combo_count();
+    combo_key_index_built = true;
+    combo_key_index_valid = false;
+    // state of any combo may be stale, let the next clear_combos() look at all of them
+    memset(combo_dirty, 0xFF, sizeof(combo_dirty));
+
+    if (combo_key_index_count > COMBO_KEY_INDEX_LENGTH) return;
+
+    for (uint16_t combo_index = 0; combo_index < combo_key_index_count; ++combo_index) {
+        const uint16_t *keys = combo_get(combo_index)->keys;
+        uint16_t        key;
+
+        for (uint8_t key_i = 0; (key = pgm_read_word(&keys[key_i])) != COMBO_END; ++key_i) {
+            // insertion sort, equal keycodes stay in combo order
+            uint16_t i = combo_key_index_size;
+            while (i > 0 && combo_key_index[i - 1].keycode > key) {
+                i--;
+            }
+            if (i > 0 && combo_key_index[i - 1].keycode == key && combo_key_index[i - 1].combo_index == combo_index) {
+                // key listed twice in the same combo
+                continue;
+            }
+            if (combo_key_index_size == COMBO_KEY_INDEX_LENGTH) {
+                // index too small, fall back to scanning all combos
+                return;
+            }
+            memmove(&combo_key_index[i + 1], &combo_key_index[i], (combo_key_index_size - i) * sizeof(combo_key_index_t));
+            combo_key_index[i] = (combo_key_index_t){
+                .keycode     = key,
+                .combo_index = combo_index,
+            };
+            combo_key_index_size++;
+        }
+    }
+
+    combo_key_index_valid = true;
+}
+
+static uint16_t find_combo_key_index(uint16_t keycode) {
+    // lower bound of keycode
+    uint16_t low = 0, high = combo_key_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEY_INDEX_LENGTH
+    if (combo_key_index_valid && combo_key_index_count == combo_count()) {
+        for (index = 0; index < combo_key_index_count; ++index) {
+            if (!(combo_dirty[index / 8] & (1 << (index % 8)))) {
+                continue;
+            }
+            combo_t *combo = combo_get(index);
+            if (!COMBO_ACTIVE(combo)) {
+                RESET_COMBO_STATE(combo);
+                combo_dirty[index / 8] &= ~(1 << (index % 8));
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -564,10 +652,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX_LENGTH
+    if (!combo_key_index_built || combo_key_index_count != combo_count()) {
+        build_combo_key_index();
+    }
+
+    if (combo_key_index_valid) {
+        for (uint16_t i = find_combo_key_index(keycode); i < combo_key_index_size && combo_key_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_key_index[i].combo_index;
+            combo_dirty[idx / 8] |= 1 << (idx % 8);
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -625,6 +728,17 @@ void combo_task(void) {
 #endif
 }
 
+/** \brief Time left until combo_task() resolves the buffered keys */
+uint32_t combo_deadline(void) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        return elapsed > longest_term ? 0 : longest_term - elapsed + 1;
+    }
+#endif
+    return NO_DEADLINE;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -75,6 +75,7 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+uint32_t combo_deadline(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
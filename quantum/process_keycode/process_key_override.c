@@ -86,6 +86,29 @@ static bool enabled = true;
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+// Trigger to override index, sorted by trigger then by position in key_overrides, so that only the overrides a key can activate are looked at. Overrides without a trigger (KC_NO) sort first.
+typedef struct {
+    uint16_t trigger;
+    uint8_t  override_index;
+} key_override_index_t;
+static key_override_index_t key_override_index[KEY_OVERRIDE_INDEX_LENGTH];
+static uint8_t              key_override_index_size = 0;
+// The key_overrides array the index was built for
+static const key_override_t **key_override_index_source = NULL;
+static bool                   key_override_index_valid  = false;
+// Modifiers that are a trigger or negative modifier of any override, no other modifier can change whether an override matches
+static uint8_t key_override_relevant_mods = 0xFF;
+
+// Candidate overrides for an event, up to three ranges of the index that are merged in key_overrides order
+#    define KEY_OVERRIDE_CANDIDATE_RANGES 3
+typedef struct {
+    uint8_t pos[KEY_OVERRIDE_CANDIDATE_RANGES];
+    uint8_t end[KEY_OVERRIDE_CANDIDATE_RANGES];
+    uint8_t count;
+} key_override_candidates_t;
+#endif
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -245,14 +268,132 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+static void build_key_override_index(void) {
+    key_override_index_size    = 0;
+    key_override_index_source  = key_overrides;
+    key_override_index_valid   = false;
+    key_override_relevant_mods = 0xFF;
+
+    if (key_overrides == NULL) {
+        return;
+    }
+
+    uint8_t relevant_mods = 0;
+    for (uint8_t override_index = 0; key_overrides[override_index] != NULL; override_index++) {
+        const key_override_t *const override = key_overrides[override_index];
+
+        if (key_override_index_size == KEY_OVERRIDE_INDEX_LENGTH || override_index == UINT8_MAX - 1) {
+            // Index too small, fall back to scanning all overrides
+            return;
+        }
+
+        // Insertion sort, overrides with the same trigger stay in key_overrides order
+        uint8_t i = key_override_index_size;
+        while (i > 0 && key_override_index[i - 1].trigger > override->trigger) {
+            key_override_index[i] = key_override_index[i - 1];
+            i--;
+        }
+        key_override_index[i] = (key_override_index_t){
+            .trigger        = override->trigger,
+            .override_index = override_index,
+        };
+        key_override_index_size++;
+
+        relevant_mods |= override->trigger_mods | override->negative_mod_mask;
+    }
+
+    key_override_relevant_mods = relevant_mods;
+    key_override_index_valid   = true;
+}
+
+static uint8_t find_key_override_index(const uint16_t trigger) {
+    // Lower bound of trigger
+    uint8_t low = 0, high = key_override_index_size;
+    while (low < high) {
+        uint8_t mid = low + (high - low) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void add_key_override_candidates(key_override_candidates_t *candidates, const uint16_t trigger) {
+    uint8_t pos = find_key_override_index(trigger);
+    uint8_t end = pos;
+    while (end < key_override_index_size && key_override_index[end].trigger == trigger) {
+        end++;
+    }
+
+    if (pos != end) {
+        candidates->pos[candidates->count] = pos;
+        candidates->end[candidates->count] = end;
+        candidates->count++;
+    }
+}
+
+/** Collects the overrides that can activate on an event. A non-mod key down can only activate overrides it is the trigger of, a mod event can also activate the overrides of the last non-mod key pressed down. Overrides without a trigger are always candidates. */
+static void find_key_override_candidates(key_override_candidates_t *candidates, const uint16_t keycode, const bool is_mod) {
+    candidates->count = 0;
+    add_key_override_candidates(candidates, KC_NO);
+    if (keycode != KC_NO) {
+        add_key_override_candidates(candidates, keycode);
+    }
+    if (is_mod && last_key_down != KC_NO && last_key_down != keycode) {
+        add_key_override_candidates(candidates, last_key_down);
+    }
+}
+
+/** Returns the next candidate override in key_overrides order, or NULL if there are none left */
+static const key_override_t *next_key_override_candidate(key_override_candidates_t *candidates) {
+    uint8_t next = KEY_OVERRIDE_CANDIDATE_RANGES;
+    for (uint8_t i = 0; i < candidates->count; i++) {
+        if (candidates->pos[i] == candidates->end[i]) {
+            continue;
+        }
+        if (next == KEY_OVERRIDE_CANDIDATE_RANGES || key_override_index[candidates->pos[i]].override_index < key_override_index[candidates->pos[next]].override_index) {
+            next = i;
+        }
+    }
+
+    if (next == KEY_OVERRIDE_CANDIDATE_RANGES) {
+        return NULL;
+    }
+
+    return key_overrides[key_override_index[candidates->pos[next]++].override_index];
+}
+#endif
+
 /** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
 static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
     if (key_overrides == NULL) {
         return true;
     }
 
+    // Mods no override cares about can be ignored by the fast mods check below
+    uint8_t relevant_mods = active_mods;
+
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+    if (key_override_index_source != key_overrides) {
+        build_key_override_index();
+    }
+
+    key_override_candidates_t candidates;
+    if (key_override_index_valid) {
+        find_key_override_candidates(&candidates, keycode, is_mod);
+        relevant_mods &= key_override_relevant_mods;
+    }
+#endif
+
     for (uint8_t i = 0;; i++) {
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+        const key_override_t *const override = key_override_index_valid ? next_key_override_candidate(&candidates) : key_overrides[i];
+#else
         const key_override_t *const override = key_overrides[i];
+#endif
 
         // End of array
         if (override == NULL) {
@@ -260,7 +401,7 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
         }
 
         // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
+        if (relevant_mods == 0 && override->trigger_mods != 0) {
             key_override_printf("Not activating override: Modifiers don't match\n");
             continue;
         }
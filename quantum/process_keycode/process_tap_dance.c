@@ -188,6 +188,15 @@ void tap_dance_task(void) {
     }
 }
 
+/** \brief Time left until tap_dance_task() finishes the active dance */
+uint32_t tap_dance_deadline(void) {
+    if (!active_td) return NO_DEADLINE;
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    return elapsed > term ? 0 : term - elapsed + 1;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
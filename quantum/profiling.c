@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "profiling.h"
+#include "util.h"
+
+static profile_stats_t profile_stats[PROFILE_SLOT_COUNT];
+
+void profile_record(profile_slot_t slot, uint32_t cycles) {
+    profile_stats_t *stats  = &profile_stats[slot];
+    uint32_t         scaled = cycles >> PROFILE_HISTOGRAM_SHIFT;
+    uint8_t          bucket = scaled ? MIN(32 - __builtin_clz(scaled), PROFILE_HISTOGRAM_BUCKETS - 1) : 0;
+
+    if (stats->buckets[bucket] < UINT16_MAX) {
+        stats->buckets[bucket]++;
+    }
+    stats->count++;
+    stats->total += cycles;
+    if (cycles > stats->max) {
+        stats->max = cycles;
+    }
+}
+
+const profile_stats_t *profile_get_stats(profile_slot_t slot) {
+    if (slot >= PROFILE_SLOT_COUNT) {
+        return NULL;
+    }
+    return &profile_stats[slot];
+}
+
+void profile_reset(void) {
+    memset(profile_stats, 0, sizeof(profile_stats));
+}
@@ -0,0 +1,73 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+/*
+    This API keeps always-on cycle count histograms for the hot paths of the
+    main loop, so they can be read back from a running keyboard over raw HID
+    (see `id_profile_stats` in via.h) without a debug console.
+
+    Timestamps come from TIMESTAMP_GETTER in basic_profiling.h, which is the
+    DWT cycle counter on ChibiOS/ARMv7-M.
+
+    Usage example:
+
+        #include "profiling.h"
+
+        // Original code:
+        matrix_scan();
+
+        // Replace with:
+        PROFILE_SLOT(PROFILE_MATRIX_SCAN, matrix_scan());
+
+    Without PROFILING_ENABLE the wrapped call is left as is.
+*/
+
+typedef enum profile_slot_t {
+    PROFILE_MATRIX_SCAN,
+    PROFILE_DEBOUNCE,
+    PROFILE_PROCESS_RECORD,
+    PROFILE_RGB_RENDER,
+    PROFILE_RGB_FLUSH,
+    PROFILE_REPORT_SEND,
+    PROFILE_WIRELESS_TASK,
+    PROFILE_SLOT_COUNT,
+} profile_slot_t;
+
+/* Bucket 0 counts calls shorter than 2^PROFILE_HISTOGRAM_SHIFT cycles, every
+ * further bucket doubles the range and the last one takes everything longer. */
+#ifndef PROFILE_HISTOGRAM_SHIFT
+#    define PROFILE_HISTOGRAM_SHIFT 6
+#endif
+#ifndef PROFILE_HISTOGRAM_BUCKETS
+#    define PROFILE_HISTOGRAM_BUCKETS 12
+#endif
+
+typedef struct profile_stats_t {
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+    uint16_t buckets[PROFILE_HISTOGRAM_BUCKETS]; // saturate at UINT16_MAX
+} profile_stats_t;
+
+#ifdef PROFILING_ENABLE
+#    include "basic_profiling.h"
+
+void                   profile_record(profile_slot_t slot, uint32_t cycles);
+const profile_stats_t *profile_get_stats(profile_slot_t slot);
+void                   profile_reset(void);
+
+#    define PROFILE_SLOT(slot, call)                                  \
+        do {                                                          \
+            const uint32_t profile_start = TIMESTAMP_GETTER;          \
+            call;                                                     \
+            profile_record((slot), TIMESTAMP_GETTER - profile_start); \
+        } while (0)
+#else
+#    define PROFILE_SLOT(slot, call) \
+        do {                         \
+            call;                    \
+        } while (0)
+#endif // PROFILING_ENABLE
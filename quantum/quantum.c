@@ -16,6 +16,10 @@
 
 #include "quantum.h"
 
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+#    include "wear_leveling.h"
+#endif
+
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
 #    include "process_backlight.h"
 #endif
@@ -174,6 +178,9 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+    wear_leveling_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -296,6 +303,13 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC) && !defined(SEND_STRING_ASYNC_NO_CANCEL)
+    // Any new key press stops a macro that is still typing
+    if (record->event.pressed) {
+        send_string_async_cancel();
+    }
+#endif
+
     if (!(
 #if defined(KEY_LOCK_ENABLE)
             // Must run first to be able to mask key_up events.
@@ -504,6 +518,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_BACK)
+    // Settings changed just before the host went to sleep must survive a power loss
+    wear_leveling_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
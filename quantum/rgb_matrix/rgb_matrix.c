@@ -23,6 +23,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "profiling.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -72,6 +73,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+led_polar_t g_rgb_matrix_polar[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 #ifdef RGB_MATRIX_DRIVER_SHUTDOWN_ENABLE
@@ -90,7 +94,10 @@ static uint32_t rgb_matrix_timeout = RGB_MATRIX_TIMEOUT;
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// last_hit_buffer is kept as a ring starting at last_hit_start, it is
+// unrolled into g_last_hit_tracker once per frame.
 static last_hit_t last_hit_buffer;
+static uint8_t    last_hit_start = 0;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -189,16 +196,13 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
+        // overwrite the oldest hit once the ring is full
+        if (last_hit_buffer.count == LED_HITS_TO_REMEMBER) {
+            last_hit_start = (last_hit_start + 1) % LED_HITS_TO_REMEMBER;
+            last_hit_buffer.count--;
+        }
+        uint8_t index                = (last_hit_start + last_hit_buffer.count) % LED_HITS_TO_REMEMBER;
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
@@ -280,12 +284,16 @@ static void rgb_task_timers(void) {
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     uint8_t count = last_hit_buffer.count;
+    uint8_t start = last_hit_start;
     for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
+        uint8_t index = (start + i) % LED_HITS_TO_REMEMBER;
+        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[index]) {
+            // hits are ordered oldest first, so only the oldest ones can expire
+            last_hit_start = (last_hit_start + 1) % LED_HITS_TO_REMEMBER;
             last_hit_buffer.count--;
             continue;
         }
-        last_hit_buffer.tick[i] += deltaTime;
+        last_hit_buffer.tick[index] += deltaTime;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -303,7 +311,14 @@ static void rgb_task_start(void) {
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        uint8_t index               = (last_hit_start + i) % LED_HITS_TO_REMEMBER;
+        g_last_hit_tracker.x[i]     = last_hit_buffer.x[index];
+        g_last_hit_tracker.y[i]     = last_hit_buffer.y[index];
+        g_last_hit_tracker.index[i] = last_hit_buffer.index[index];
+        g_last_hit_tracker.tick[i]  = last_hit_buffer.tick[index];
+    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -411,7 +426,7 @@ void rgb_matrix_task(void) {
             rgb_task_start();
             break;
         case RENDERING:
-            rgb_task_render(effect);
+            PROFILE_SLOT(PROFILE_RGB_RENDER, rgb_task_render(effect));
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
@@ -420,7 +435,7 @@ void rgb_matrix_task(void) {
             }
             break;
         case FLUSHING:
-            rgb_task_flush(effect);
+            PROFILE_SLOT(PROFILE_RGB_FLUSH, rgb_task_flush(effect));
             break;
         case SYNCING:
             rgb_task_sync();
@@ -428,6 +443,14 @@ void rgb_matrix_task(void) {
     }
 }
 
+/** \brief Time left until rgb_matrix_task() has a frame to work on */
+uint32_t rgb_matrix_deadline(void) {
+    if (rgb_task_state != SYNCING) return 0;
+
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed >= RGB_MATRIX_LED_FLUSH_LIMIT ? 0 : RGB_MATRIX_LED_FLUSH_LIMIT - elapsed;
+}
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -494,6 +517,16 @@ void rgb_matrix_init(void) {
     driver_shutdown = false;
 #endif
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    // LED positions never move, so the radial effects read these instead of recomputing them every frame
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx                  = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy                  = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_rgb_matrix_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_rgb_matrix_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -501,6 +534,7 @@ void rgb_matrix_init(void) {
     }
 
     last_hit_buffer.count = 0;
+    last_hit_start        = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         last_hit_buffer.tick[i] = UINT16_MAX;
     }
@@ -171,7 +171,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
-void rgb_matrix_task(void);
+void     rgb_matrix_task(void);
+uint32_t rgb_matrix_deadline(void);
 
 void rgb_matrix_none_indicators_kb(void);
 void rgb_matrix_none_indicators_user(void);
@@ -327,6 +328,9 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern led_polar_t g_rgb_matrix_polar[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -18,11 +18,16 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC
+#    include "keyboard.h"
+#    include "timer.h"
+#endif
 #ifdef LK_WIRELESS_ENABLE
 #include "wireless.h"
 #endif
@@ -344,3 +349,167 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC
+typedef struct {
+    const char *       string;
+    send_string_read_t read;
+    uint8_t            interval;
+} send_string_job_t;
+
+static send_string_job_t send_string_queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t           send_string_queue_head  = 0;
+static uint8_t           send_string_queue_count = 0;
+static uint32_t          send_string_resume_time = 0;
+static bool              send_string_waiting     = false;
+// Keys pressed by SS_DOWN and not yet released by SS_UP, one bit per keycode
+static uint8_t send_string_held_keys[256 / 8];
+static bool    send_string_holds_keys = false;
+
+static char send_string_read_ram(const char *string) {
+    return *string;
+}
+
+bool send_string_async_with_reader(const char *string, uint8_t interval, send_string_read_t read) {
+    if (send_string_queue_count >= SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    send_string_job_t *job = &send_string_queue[(send_string_queue_head + send_string_queue_count) % SEND_STRING_ASYNC_QUEUE_SIZE];
+
+    job->string   = string;
+    job->read     = read;
+    job->interval = interval;
+    send_string_queue_count++;
+    return true;
+}
+
+bool send_string_async(const char *string, uint8_t interval) {
+    return send_string_async_with_reader(string, interval, send_string_read_ram);
+}
+
+#    if defined(__AVR__)
+static char send_string_read_P(const char *string) {
+    return pgm_read_byte(string);
+}
+
+bool send_string_async_P(const char *string, uint8_t interval) {
+    return send_string_async_with_reader(string, interval, send_string_read_P);
+}
+#    endif
+
+bool send_string_async_is_active(void) {
+    return send_string_queue_count > 0;
+}
+
+void send_string_async_cancel(void) {
+    if (send_string_queue_count == 0) {
+        return;
+    }
+    send_string_queue_count = 0;
+    send_string_waiting     = false;
+    if (send_string_holds_keys) {
+        // Don't leave anything pressed that the cut off macro would have released,
+        // but keep whatever the user is holding
+        for (uint16_t keycode = 0; keycode < 256; keycode++) {
+            if (send_string_held_keys[keycode / 8] & (1 << (keycode % 8))) {
+                unregister_code(keycode);
+            }
+        }
+        memset(send_string_held_keys, 0, sizeof(send_string_held_keys));
+        send_string_holds_keys = false;
+    }
+}
+
+/** \brief send_string_async_ready_user
+ *
+ * Return false to pause playback, e.g. while a transport can't take more reports.
+ */
+__attribute__((weak)) bool send_string_async_ready_user(void) {
+    return true;
+}
+
+/** \brief send_string_async_ready_kb
+ *
+ * Return false to pause playback, e.g. while a transport can't take more reports.
+ */
+__attribute__((weak)) bool send_string_async_ready_kb(void) {
+    return send_string_async_ready_user();
+}
+
+static void send_string_async_finish(void) {
+    send_string_queue_head = (send_string_queue_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    send_string_queue_count--;
+}
+
+void send_string_async_task(void) {
+    if (send_string_queue_count == 0) {
+        return;
+    }
+    if (send_string_waiting) {
+        if (!timer_expired32(timer_read32(), send_string_resume_time)) {
+            return;
+        }
+        send_string_waiting = false;
+    }
+    if (!send_string_async_ready_kb()) {
+        return;
+    }
+
+    // Play a single token per pass, then hand the main loop back
+    send_string_job_t *job        = &send_string_queue[send_string_queue_head];
+    uint32_t           ms         = job->interval;
+    char               ascii_code = job->read(job->string);
+    if (!ascii_code) {
+        send_string_async_finish();
+        return;
+    }
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code      = job->read(++job->string);
+        bool    has_arg = ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE || ascii_code == SS_DELAY_CODE;
+        uint8_t keycode = has_arg ? job->read(++job->string) : 0;
+        // A truncated code ends the string, where the blocking version would run past the terminator
+        if (!ascii_code || (has_arg && !keycode)) {
+            send_string_async_finish();
+            return;
+        }
+        if (ascii_code == SS_TAP_CODE) {
+            tap_code(keycode);
+        } else if (ascii_code == SS_DOWN_CODE) {
+            register_code(keycode);
+            send_string_held_keys[keycode / 8] |= 1 << (keycode % 8);
+            send_string_holds_keys = true;
+        } else if (ascii_code == SS_UP_CODE) {
+            unregister_code(keycode);
+            send_string_held_keys[keycode / 8] &= ~(1 << (keycode % 8));
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint32_t delay = 0;
+            while (isdigit(keycode)) {
+                delay *= 10;
+                delay += keycode - '0';
+                keycode = job->read(++job->string);
+            }
+            ms += delay;
+        }
+    } else {
+        send_char(ascii_code);
+    }
+    ++job->string;
+
+    if (ms) {
+        send_string_resume_time = timer_read32() + ms;
+        send_string_waiting     = true;
+    }
+}
+
+uint32_t send_string_async_deadline(void) {
+    if (send_string_queue_count == 0) {
+        return NO_DEADLINE;
+    }
+    if (send_string_waiting) {
+        uint32_t now = timer_read32();
+        return timer_expired32(now, send_string_resume_time) ? 0 : TIMER_DIFF_32(send_string_resume_time, now);
+    }
+    // Whatever holds playback back has its own deadline to drain by
+    return send_string_async_ready_kb() ? 0 : NO_DEADLINE;
+}
+#endif // SEND_STRING_ASYNC
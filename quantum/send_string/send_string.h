@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -151,4 +152,81 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC) || defined(__DOXYGEN__)
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+
+/**
+ * \brief Reads one character of a queued string, so it may live in RAM, PROGMEM or EEPROM.
+ */
+typedef char (*send_string_read_t)(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop.
+ *
+ * One character or code is played per main loop pass, and delays no longer block the keyboard.
+ * The string is not copied, so it must stay valid until it has been typed out.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return `false` if the queue is full and the string was dropped.
+ */
+bool send_string_async(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a string of ASCII characters stored anywhere `read` can fetch them from.
+ *
+ * \param string The address of the string to type out, as understood by `read`.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \param read The function returning the character at a given address.
+ *
+ * \return `false` if the queue is full and the string was dropped.
+ */
+bool send_string_async_with_reader(const char *string, uint8_t interval, send_string_read_t read);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async(string, interval).
+ */
+bool send_string_async_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string, interval) send_string_async(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string), interval).
+ */
+#    define SEND_STRING_QUEUED(string, interval) send_string_async_P(PSTR(string), interval)
+
+/**
+ * \brief Whether any queued string is still being typed out.
+ */
+bool send_string_async_is_active(void);
+
+/**
+ * \brief Drop every queued string, releasing any key still held by an `SS_DOWN()`.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Whether playback may go on, override to pause it while reports can't be taken.
+ */
+bool send_string_async_ready_kb(void);
+bool send_string_async_ready_user(void);
+
+/**
+ * \brief Play the next character of the queued strings. Called from the main loop.
+ */
+void send_string_async_task(void);
+
+/**
+ * \brief Milliseconds until send_string_async_task() has work to do, or `NO_DEADLINE`.
+ */
+uint32_t send_string_async_deadline(void);
+#endif
+
 /** \} */
@@ -0,0 +1,9 @@
+transaction_batch_DEFS := -DSPLIT_TRANSACTION_BATCH_SIZE=24
+
+transaction_batch_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/transaction_batch_tests.cpp \
+    $(QUANTUM_PATH)/split_common/transaction_batch.c \
+    $(QUANTUM_PATH)/crc.c
+
+transaction_batch_INC := \
+    $(QUANTUM_PATH)/split_common
@@ -0,0 +1,162 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cstring>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transaction_batch.h"
+}
+
+// Transaction 2 has a slave callback and can't be batched
+static const uint8_t transaction_sizes[] = {4, 2, 0, 12, 10};
+
+static uint8_t master_buffers[sizeof(transaction_sizes)][16];
+static uint8_t slave_buffers[sizeof(transaction_sizes)][16];
+
+static uint8_t *buffer(uint8_t (*buffers)[16], int8_t trans_id, uint8_t *size) {
+    if (trans_id >= (int8_t)sizeof(transaction_sizes) || transaction_sizes[trans_id] == 0) {
+        return NULL;
+    }
+    *size = transaction_sizes[trans_id];
+    return buffers[trans_id];
+}
+
+static uint8_t *master_buffer(int8_t trans_id, uint8_t *size) {
+    return buffer(master_buffers, trans_id, size);
+}
+
+static uint8_t *slave_buffer(int8_t trans_id, uint8_t *size) {
+    return buffer(slave_buffers, trans_id, size);
+}
+
+class TransactionBatch : public ::testing::Test {
+   protected:
+    split_batch_t      batch         = {};
+    split_batch_sync_t frame         = {};
+    uint8_t            last_sequence = 0;
+
+    void SetUp() override {
+        memset(master_buffers, 0, sizeof(master_buffers));
+        memset(slave_buffers, 0, sizeof(slave_buffers));
+    }
+
+    void write(int8_t trans_id, uint8_t value) {
+        memset(master_buffers[trans_id], value, transaction_sizes[trans_id]);
+        split_batch_mark(&batch, trans_id);
+    }
+
+    // Only the bytes in use reach the slave, what it had in the rest of the frame stays
+    bool transfer(void) {
+        split_batch_sync_t received;
+        memset(&received, 0xAA, sizeof(received));
+        uint8_t length = split_batch_build(&batch, &frame, master_buffer);
+        memcpy(&received, &frame, SPLIT_BATCH_FRAME_SIZE(length));
+        return split_batch_apply(&received, &last_sequence, slave_buffer);
+    }
+};
+
+TEST_F(TransactionBatch, SendsOnlyTheDataInUse) {
+    write(1, 0x11);
+    write(4, 0x44);
+
+    EXPECT_EQ(split_batch_build(&batch, &frame, master_buffer), 12);
+    EXPECT_EQ(frame.changed, (1UL << 1) | (1UL << 4));
+    EXPECT_EQ(frame.sequence, 1);
+}
+
+TEST_F(TransactionBatch, AppliesTheChangedTransactions) {
+    write(0, 0x10);
+    write(3, 0x33);
+
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(last_sequence, 1);
+    EXPECT_EQ(memcmp(slave_buffers[0], master_buffers[0], transaction_sizes[0]), 0);
+    EXPECT_EQ(memcmp(slave_buffers[3], master_buffers[3], transaction_sizes[3]), 0);
+    EXPECT_EQ(slave_buffers[1][0], 0);
+}
+
+TEST_F(TransactionBatch, LeavesWhatDoesNotFitForTheNextFrame) {
+    write(0, 0x10);
+    write(3, 0x33);
+    write(4, 0x44);
+
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(frame.changed, (1UL << 0) | (1UL << 3));
+    EXPECT_EQ(slave_buffers[4][0], 0);
+
+    split_batch_ack(&batch, last_sequence);
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(frame.changed, 1UL << 4);
+    EXPECT_EQ(slave_buffers[4][0], 0x44);
+}
+
+TEST_F(TransactionBatch, ResendsUntilAcknowledged) {
+    write(1, 0x11);
+    split_batch_build(&batch, &frame, master_buffer);
+
+    // The frame was lost, the slave still reports the previous sequence
+    split_batch_ack(&batch, 0);
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(frame.changed, 1UL << 1);
+    EXPECT_EQ(slave_buffers[1][0], 0x11);
+
+    split_batch_ack(&batch, last_sequence);
+    EXPECT_EQ(batch.unacked, 0U);
+    EXPECT_EQ(batch.dirty, 0U);
+}
+
+TEST_F(TransactionBatch, IgnoresAFrameAlreadyApplied) {
+    write(1, 0x11);
+    EXPECT_TRUE(transfer());
+
+    memset(slave_buffers[1], 0, sizeof(slave_buffers[1]));
+    EXPECT_FALSE(split_batch_apply(&frame, &last_sequence, slave_buffer));
+    EXPECT_EQ(slave_buffers[1][0], 0);
+}
+
+TEST_F(TransactionBatch, RejectsACorruptedFrame) {
+    write(1, 0x11);
+    uint8_t length = split_batch_build(&batch, &frame, master_buffer);
+    frame.data[length - 1] ^= 0x01;
+
+    EXPECT_FALSE(split_batch_apply(&frame, &last_sequence, slave_buffer));
+    EXPECT_EQ(last_sequence, 0);
+    EXPECT_EQ(slave_buffers[1][0], 0);
+}
+
+TEST_F(TransactionBatch, RejectsUnknownTransactions) {
+    write(1, 0x11);
+    split_batch_build(&batch, &frame, master_buffer);
+    frame.changed |= 1UL << 2;
+
+    EXPECT_FALSE(split_batch_apply(&frame, &last_sequence, slave_buffer));
+}
+
+TEST_F(TransactionBatch, RejectsAZeroedFrame) {
+    EXPECT_FALSE(split_batch_apply(&frame, &last_sequence, slave_buffer));
+}
+
+TEST_F(TransactionBatch, SkipsSequenceZeroOnWrapAround) {
+    split_batch_sync(&batch, UINT8_MAX);
+    last_sequence = UINT8_MAX;
+    write(1, 0x11);
+
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(frame.sequence, 1);
+}
+
+TEST_F(TransactionBatch, ContinuesTheSequenceOfTheSlaveAfterAMasterReset) {
+    write(1, 0x11);
+    EXPECT_TRUE(transfer());
+    split_batch_ack(&batch, last_sequence);
+
+    // A fresh master would start over at the sequence the slave already applied
+    batch = {};
+    EXPECT_FALSE(batch.synced);
+    split_batch_sync(&batch, last_sequence);
+    EXPECT_TRUE(batch.synced);
+
+    write(1, 0x22);
+    EXPECT_TRUE(transfer());
+    EXPECT_EQ(slave_buffers[1][0], 0x22);
+}
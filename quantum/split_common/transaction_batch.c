@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "transaction_batch.h"
+#include "crc.h"
+
+#define SPLIT_BATCH_MAX_TRANSACTIONS (sizeof(uint32_t) * 8)
+
+static uint8_t split_batch_checksum(const split_batch_sync_t *frame, uint8_t length) {
+    split_batch_sync_t copy;
+    memcpy(&copy, frame, SPLIT_BATCH_FRAME_SIZE(length));
+    copy.checksum = 0;
+    return crc8(&copy, SPLIT_BATCH_FRAME_SIZE(length));
+}
+
+void split_batch_mark(split_batch_t *batch, int8_t trans_id) {
+    batch->dirty |= (1UL << trans_id);
+}
+
+void split_batch_sync(split_batch_t *batch, uint8_t sequence) {
+    batch->sequence = sequence;
+    batch->synced   = true;
+}
+
+uint8_t split_batch_build(split_batch_t *batch, split_batch_sync_t *frame, split_batch_buffer_t buffer) {
+    uint32_t pending = batch->dirty | batch->unacked;
+    uint8_t  length  = 0;
+
+    frame->changed = 0;
+    for (int8_t i = 0; i < SPLIT_BATCH_MAX_TRANSACTIONS; ++i) {
+        if (!(pending & (1UL << i))) continue;
+        uint8_t  size = 0;
+        uint8_t *data = buffer(i, &size);
+        if (length + size > SPLIT_TRANSACTION_BATCH_SIZE) continue; // left for the next frame
+        memcpy(&frame->data[length], data, size);
+        length += size;
+        frame->changed |= (1UL << i);
+    }
+
+    if (++batch->sequence == 0) {
+        batch->sequence = 1;
+    }
+    frame->sequence = batch->sequence;
+    frame->checksum = split_batch_checksum(frame, length);
+
+    batch->dirty   = pending & ~frame->changed;
+    batch->unacked = frame->changed;
+    return length;
+}
+
+void split_batch_ack(split_batch_t *batch, uint8_t sequence) {
+    if (sequence == batch->sequence) {
+        batch->unacked = 0;
+    }
+}
+
+bool split_batch_apply(const split_batch_sync_t *frame, uint8_t *last_sequence, split_batch_buffer_t buffer) {
+    if (frame->sequence == 0 || frame->sequence == *last_sequence) {
+        return false;
+    }
+
+    // The length in use follows from the transactions carried, the rest of the frame was never sent
+    uint16_t length = 0;
+    for (int8_t i = 0; i < SPLIT_BATCH_MAX_TRANSACTIONS; ++i) {
+        if (!(frame->changed & (1UL << i))) continue;
+        uint8_t size = 0;
+        if (buffer(i, &size) == NULL) return false;
+        length += size;
+    }
+    if (length > SPLIT_TRANSACTION_BATCH_SIZE || frame->checksum != split_batch_checksum(frame, length)) {
+        return false;
+    }
+
+    length = 0;
+    for (int8_t i = 0; i < SPLIT_BATCH_MAX_TRANSACTIONS; ++i) {
+        if (!(frame->changed & (1UL << i))) continue;
+        uint8_t  size = 0;
+        uint8_t *data = buffer(i, &size);
+        memcpy(data, &frame->data[length], size);
+        length += size;
+    }
+
+    *last_sequence = frame->sequence;
+    return true;
+}
@@ -0,0 +1,74 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+    Encoding of the batch frame, which carries every value the master wrote
+    during a scan cycle to the slave, see SPLIT_TRANSACTION_BATCH. Only the
+    header and the data in use are sent.
+*/
+
+#ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#    define SPLIT_TRANSACTION_BATCH_SIZE 32
+#endif // SPLIT_TRANSACTION_BATCH_SIZE
+
+#ifndef SPLIT_TRANSACTION_BATCH_SHORT_SIZE
+#    define SPLIT_TRANSACTION_BATCH_SHORT_SIZE 8
+#endif // SPLIT_TRANSACTION_BATCH_SHORT_SIZE
+
+typedef struct _split_batch_sync_t {
+    uint32_t changed;  // bit per transaction ID carried in data, in ascending ID order
+    uint8_t  sequence; // never 0, so that a zeroed frame is not mistaken for a real one
+    uint8_t  checksum; // crc8 of the header and the data in use, calculated with this field set to 0
+    uint8_t  data[SPLIT_TRANSACTION_BATCH_SIZE];
+} split_batch_sync_t;
+
+// Number of bytes of a frame carrying `data_length` bytes of data
+#define SPLIT_BATCH_FRAME_SIZE(data_length) (offsetof(split_batch_sync_t, data) + (data_length))
+
+/**
+ * @brief Returns the initiator2target buffer of a transaction and stores its size, NULL if it can't be batched.
+ */
+typedef uint8_t *(*split_batch_buffer_t)(int8_t trans_id, uint8_t *size);
+
+typedef struct {
+    uint32_t dirty;    // transactions written since they were last put in a frame
+    uint32_t unacked;  // transactions carried by the last frame, until the slave reports having applied it
+    uint8_t  sequence; // sequence number of the last frame
+    bool     synced;   // sequence continues from the last frame the slave applied
+} split_batch_t;
+
+/**
+ * @brief Marks a transaction to be sent with the next frame.
+ */
+void split_batch_mark(split_batch_t *batch, int8_t trans_id);
+
+/**
+ * @brief Continues the sequence from the last frame the slave applied, so a frame
+ * sent before the master was reset is not taken for the next one.
+ */
+void split_batch_sync(split_batch_t *batch, uint8_t sequence);
+
+/**
+ * @brief Builds the next frame from the marked transactions and the ones the slave
+ * has not acknowledged yet.
+ *
+ * @return The number of bytes of data in use, see SPLIT_BATCH_FRAME_SIZE()
+ */
+uint8_t split_batch_build(split_batch_t *batch, split_batch_sync_t *frame, split_batch_buffer_t buffer);
+
+/**
+ * @brief Handles the sequence number of the last frame the slave applied.
+ */
+void split_batch_ack(split_batch_t *batch, uint8_t sequence);
+
+/**
+ * @brief Spreads a frame received by the slave out over the transaction buffers.
+ *
+ * @return true The frame was new and valid, `last_sequence` is updated
+ */
+bool split_batch_apply(const split_batch_sync_t *frame, uint8_t *last_sequence, split_batch_buffer_t buffer);
@@ -21,9 +21,16 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifndef SPLIT_TRANSACTION_BATCH
     GET_SLAVE_MATRIX_CHECKSUM,
+#endif // SPLIT_TRANSACTION_BATCH
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    PUT_BATCH_SHORT,
+    PUT_BATCH,
+#endif // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -80,7 +80,12 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BATCH
+// Writes are collected into a single frame sent at the end of transactions_master(), see transaction_batch_write()
+#    define transport_write(id, data, length) transaction_batch_write(id, data, length)
+#else // SPLIT_TRANSACTION_BATCH
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#endif // SPLIT_TRANSACTION_BATCH
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -139,6 +144,51 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+
+_Static_assert(SPLIT_BATCH_FRAME_SIZE(SPLIT_TRANSACTION_BATCH_SIZE) <= UINT8_MAX, "SPLIT_TRANSACTION_BATCH_SIZE too large for a single transaction");
+_Static_assert(SPLIT_TRANSACTION_BATCH_SHORT_SIZE <= SPLIT_TRANSACTION_BATCH_SIZE, "SPLIT_TRANSACTION_BATCH_SHORT_SIZE larger than SPLIT_TRANSACTION_BATCH_SIZE");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= 32, "Batch bitmaps hold one bit per transaction in a uint32_t");
+
+static struct {
+    split_batch_t frames;    // transactions still to be sent, and the sequence of the last frame
+    uint32_t      last_sent; // time the last frame was sent, so a lost frame gets sent again
+    bool          resend;    // the last frame may not have reached the slave
+} batch_state;
+
+static bool transaction_batchable(int8_t trans_id) {
+    split_transaction_desc_t *trans = &split_transaction_table[trans_id];
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPC request data has a variable length, and has to arrive before EXECUTE_RPC
+    if (trans_id == PUT_RPC_REQ_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return trans->slave_callback == NULL && trans->target2initiator_buffer_size == 0 && trans->initiator2target_buffer_size <= SPLIT_TRANSACTION_BATCH_SIZE;
+}
+
+static uint8_t *transaction_batch_buffer(int8_t trans_id, uint8_t *size) {
+    if (trans_id >= NUM_TOTAL_TRANSACTIONS || !transaction_batchable(trans_id)) {
+        return NULL;
+    }
+    split_transaction_desc_t *trans = &split_transaction_table[trans_id];
+    *size                           = trans->initiator2target_buffer_size;
+    return split_trans_initiator2target_buffer(trans);
+}
+
+static bool transaction_batch_write(int8_t trans_id, const void *source, size_t length) {
+    if (!transaction_batchable(trans_id)) {
+        return transport_execute_transaction(trans_id, source, length, NULL, 0);
+    }
+
+    // Stage the data in the local shared memory, exactly as a transaction would, and send it with the next frame
+    split_transaction_desc_t *trans = &split_transaction_table[trans_id];
+    size_t                    len   = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    memcpy(split_trans_initiator2target_buffer(trans), source, len);
+    split_batch_mark(&batch_state.frames, trans_id);
+    return true;
+}
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
@@ -173,6 +223,17 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+static uint8_t smatrix_checksum(const split_slave_matrix_sync_t *smatrix) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    // The sequence tells the master which frame to stop resending, so it is covered as well
+    return crc8(&smatrix->batch_sequence, sizeof(split_slave_matrix_sync_t) - offsetof(split_slave_matrix_sync_t, batch_sequence));
+#else
+    return crc8(smatrix->matrix, sizeof(smatrix->matrix));
+#endif // SPLIT_TRANSACTION_BATCH
+}
+
+#ifndef SPLIT_TRANSACTION_BATCH
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -188,19 +249,32 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     return okay;
 }
 
+#endif // SPLIT_TRANSACTION_BATCH
+
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
-    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = smatrix_checksum(&split_shmem->smatrix);
 }
 
+#ifdef SPLIT_TRANSACTION_BATCH
+
+// The slave matrix is retrieved together with the batch frame, see below
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER()
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS [GET_SLAVE_MATRIX_DATA] = trans_target2initiator_initializer(smatrix),
+
+#else // SPLIT_TRANSACTION_BATCH
+
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -884,6 +958,136 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Batch
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+// Builds the next frame, and returns the transaction that sends no more of it than is in use
+static int8_t batch_build_frame(split_batch_sync_t *frame, uint8_t *size) {
+    uint8_t length = split_batch_build(&batch_state.frames, frame, transaction_batch_buffer);
+    *size          = SPLIT_BATCH_FRAME_SIZE(length);
+    return length <= SPLIT_TRANSACTION_BATCH_SHORT_SIZE ? PUT_BATCH_SHORT : PUT_BATCH;
+}
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+static bool batch_in_flight = false;
+static bool batch_frame_in_flight;
+
+static void batch_begin_exchange(void) {
+    if (batch_state.frames.unacked && timer_elapsed32(batch_state.last_sent) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_state.resend = true;
+    }
+
+    batch_frame_in_flight = batch_state.frames.dirty || batch_state.resend;
+    if (batch_frame_in_flight) {
+        split_batch_sync_t frame;
+        uint8_t            size;
+        int8_t             trans_id = batch_build_frame(&frame, &size);
+        batch_in_flight             = transport_begin_transaction(trans_id, &frame, size);
+        batch_state.resend    = true; // until the transaction is known to have completed
+        batch_state.last_sent = timer_read32();
+    } else {
+        batch_in_flight = transport_begin_transaction(GET_SLAVE_MATRIX_DATA, NULL, 0);
+    }
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static bool batch_exchange(split_slave_matrix_sync_t *smatrix) {
+    bool okay;
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    // Collect the transaction started at the end of the previous pass, it went over the wire while this half was scanning
+    if (batch_in_flight) {
+        batch_in_flight = false;
+        okay            = transport_end_transaction(smatrix, sizeof(split_slave_matrix_sync_t));
+        if (batch_frame_in_flight) {
+            batch_state.resend = !okay;
+        }
+        return okay;
+    }
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+    if (!batch_state.frames.synced) {
+        // The slave may still hold a frame sent before this half was reset, carry on from its sequence
+        okay = transport_read(GET_SLAVE_MATRIX_DATA, smatrix, sizeof(split_slave_matrix_sync_t));
+        if (okay && smatrix->checksum == smatrix_checksum(smatrix)) {
+            split_batch_sync(&batch_state.frames, smatrix->batch_sequence);
+        }
+        return okay;
+    }
+
+    if (batch_state.frames.unacked && timer_elapsed32(batch_state.last_sent) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_state.resend = true;
+    }
+
+    if (batch_state.frames.dirty || batch_state.resend) {
+        // One frame carries everything written this cycle, and brings the slave matrix back in the same transaction
+        split_batch_sync_t frame;
+        uint8_t            size;
+        int8_t             trans_id = batch_build_frame(&frame, &size);
+        okay                        = transport_execute_transaction(trans_id, &frame, size, smatrix, sizeof(split_slave_matrix_sync_t));
+        batch_state.resend    = !okay;
+        batch_state.last_sent = timer_read32();
+    } else {
+        okay = transport_read(GET_SLAVE_MATRIX_DATA, smatrix, sizeof(split_slave_matrix_sync_t));
+    }
+    return okay;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t       last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_slave_matrix_sync_t temp_smatrix;                         // holding area while we test whether or not checksum is correct
+    bool                      okay = batch_exchange(&temp_smatrix);
+
+    if (okay && temp_smatrix.checksum == smatrix_checksum(&temp_smatrix)) {
+        // Checksum matches the received data, save as the last matrix state
+        memcpy(last_matrix, temp_smatrix.matrix, sizeof(temp_smatrix.matrix));
+        split_batch_ack(&batch_state.frames, temp_smatrix.batch_sequence);
+    } else {
+        okay = false;
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    // Only overlap while the link is healthy, so that a failure is retried synchronously on the next pass
+    if (okay) {
+        batch_begin_exchange();
+    }
+#    endif // SPLIT_TRANSPORT_ASYNC
+    return okay;
+}
+
+static void batch_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_sync_t frame;
+
+    split_shared_memory_lock();
+    memcpy(&frame, &split_shmem->batch, sizeof(frame));
+    // Spread the frame out over the shared memory, where the individual handlers expect their data,
+    // the sequence it reports back is the one of the last frame applied
+    if (split_batch_apply(&frame, &split_shmem->smatrix.batch_sequence, transaction_batch_buffer)) {
+        split_shmem->smatrix.checksum = smatrix_checksum(&split_shmem->smatrix);
+    }
+    split_shared_memory_unlock();
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_SLAVE() TRANSACTION_HANDLER_SLAVE(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH_SHORT] = {SPLIT_BATCH_FRAME_SIZE(SPLIT_TRANSACTION_BATCH_SHORT_SIZE), offsetof(split_shared_memory_t, batch), sizeof_member(split_shared_memory_t, smatrix), offsetof(split_shared_memory_t, smatrix), NULL}, \
+    [PUT_BATCH]       = {SPLIT_BATCH_FRAME_SIZE(SPLIT_TRANSACTION_BATCH_SIZE), offsetof(split_shared_memory_t, batch), sizeof_member(split_shared_memory_t, smatrix), offsetof(split_shared_memory_t, smatrix), NULL},
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_SLAVE()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -914,6 +1118,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -944,10 +1149,12 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
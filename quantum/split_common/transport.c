@@ -100,7 +100,63 @@ void transport_slave_init(void) {
     soft_serial_target_init();
 }
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+static bool   async_in_flight = false;
+static bool   async_collected = false;
+static bool   async_okay;
+static int8_t async_id;
+
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    if (async_in_flight || async_collected) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    async_in_flight = soft_serial_transaction_start(id);
+    async_id        = id;
+    return async_in_flight;
+}
+
+static void transport_collect_transaction(void) {
+    if (async_in_flight) {
+        async_in_flight = false;
+        async_collected = true;
+        async_okay      = soft_serial_transaction_finish();
+    }
+}
+
+bool transport_end_transaction(void *target2initiator_buf, uint16_t target2initiator_length) {
+    transport_collect_transaction();
+    if (!async_collected) {
+        return false;
+    }
+
+    async_collected = false;
+    if (!async_okay) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[async_id];
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    // The link is needed, so wait for the transaction in flight and keep its result for transport_end_transaction()
+    transport_collect_transaction();
+#    endif // SPLIT_TRANSPORT_ASYNC
+
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
@@ -31,6 +31,13 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_TRANSACTION_BATCH
+#    include "transaction_batch.h"
+#    if defined(SERIAL_DRIVER_USART_DMA) && !defined(USE_I2C)
+#        define SPLIT_TRANSPORT_ASYNC
+#    endif
+#endif // SPLIT_TRANSACTION_BATCH
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +47,12 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Split a transaction so the master can keep scanning while it is on the wire, only one can be in flight
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+bool transport_end_transaction(void *target2initiator_buf, uint16_t target2initiator_length);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -53,7 +66,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // RGBLIGHT_ENABLE
 
 typedef struct _split_slave_matrix_sync_t {
-    uint8_t      checksum;
+    uint8_t checksum;
+#ifdef SPLIT_TRANSACTION_BATCH
+    uint8_t batch_sequence; // sequence number of the last batch frame applied by the slave
+#endif // SPLIT_TRANSACTION_BATCH
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
@@ -153,6 +169,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    split_batch_sync_t batch;
+#endif // SPLIT_TRANSACTION_BATCH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -57,6 +57,10 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(PROFILING_ENABLE)
+#    include "profiling.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -174,6 +178,47 @@ __attribute__((weak)) void via_set_device_indication(uint8_t value) {
 #endif // AUDIO_ENABLE
 }
 
+#if defined(PROFILING_ENABLE)
+// Histogram buckets that fit in one reply after the value ID, slot and page bytes
+#    define VIA_PROFILE_BUCKETS_PER_PAGE 14
+
+static void via_put_uint32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+// Page 0 holds the call count, the longest and the average call in cycles,
+// followed by the histogram shift and bucket count. Pages 1 and up hold the
+// histogram buckets as 16-bit values.
+static bool via_get_profile_stats(uint8_t slot, uint8_t page, uint8_t *data) {
+    const profile_stats_t *stats = profile_get_stats(slot);
+    if (stats == NULL) {
+        return false;
+    }
+
+    if (page == 0) {
+        via_put_uint32(&data[0], stats->count);
+        via_put_uint32(&data[4], stats->max);
+        via_put_uint32(&data[8], stats->count ? stats->total / stats->count : 0);
+        data[12] = PROFILE_HISTOGRAM_SHIFT;
+        data[13] = PROFILE_HISTOGRAM_BUCKETS;
+        return true;
+    }
+
+    uint16_t first = (page - 1) * VIA_PROFILE_BUCKETS_PER_PAGE;
+    if (first >= PROFILE_HISTOGRAM_BUCKETS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < VIA_PROFILE_BUCKETS_PER_PAGE && first + i < PROFILE_HISTOGRAM_BUCKETS; i++) {
+        data[i * 2]     = stats->buckets[first + i] >> 8;
+        data[i * 2 + 1] = stats->buckets[first + i] & 0xFF;
+    }
+    return true;
+}
+#endif // PROFILING_ENABLE
+
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     // Handle macros
@@ -337,6 +382,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     command_data[4] = value & 0xFF;
                     break;
                 }
+#ifdef PROFILING_ENABLE
+                case id_profile_stats: {
+                    if (!via_get_profile_stats(command_data[1], command_data[2], &command_data[3])) {
+                        *command_id = id_unhandled;
+                    }
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
@@ -358,6 +411,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     via_set_device_indication(value);
                     break;
                 }
+#ifdef PROFILING_ENABLE
+                case id_profile_stats: {
+                    profile_reset();
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
@@ -24,12 +24,16 @@ void MockBackingStore::reset_instance() {
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
 
+    backing_read_bulk_invoke_count = 0;
+
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
     unlock_success_callback = [](std::uint64_t) { return true; };
     write_success_callback  = [](std::uint64_t, std::uint32_t) { return true; };
     lock_success_callback   = [](std::uint64_t) { return true; };
 
+    read_bulk_success_callback = [](std::uint64_t, std::uint32_t) { return true; };
+
     write_log.clear();
 }
 
@@ -125,6 +129,22 @@ bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const
     return true;
 }
 
+bool MockBackingStore::read_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) {
+    ++backing_read_bulk_invoke_count;
+
+    // Drop out of the read early with failure if we need to
+    if (read_bulk_success_callback && !read_bulk_success_callback(backing_read_bulk_invoke_count, address)) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < item_count; ++i) {
+        if (!read(address + (i * BACKING_STORE_WRITE_SIZE), values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Backing Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,3 +172,7 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+extern "C" bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().read_bulk(address, values, item_count);
+}
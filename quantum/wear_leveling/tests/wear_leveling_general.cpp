@@ -202,3 +202,50 @@ TEST_F(WearLevelingGeneral, WriteFailure_NoSubsequentWrites) {
     wear_leveling_read(0x04, &test_val, sizeof(test_val));
     EXPECT_EQ(test_val, 0x14) << "Readback should come from cache regardless of unlock failure";
 }
+
+/**
+ * This test verifies that the write log is played back using a single bulk read when it fits in the playback window, rather than one read per entry.
+ */
+TEST_F(WearLevelingGeneral, Playback_SingleBulkRead) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        uint8_t test_val = 0x30 + i;
+        EXPECT_EQ(wear_leveling_write(0x01 + (i * 2), &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Re-init: one bulk read each for the consolidated data, its checksum, and the write log
+    uint64_t read_bulk_count = inst.read_bulk_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(inst.read_bulk_invoke_count(), read_bulk_count + 3) << "Write log should have been read in a single bulk read";
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        uint8_t test_val = 0;
+        wear_leveling_read(0x01 + (i * 2), &test_val, sizeof(test_val));
+        EXPECT_EQ(test_val, 0x30 + i) << "Readback should match the played back write log";
+    }
+}
+
+/**
+ * This test verifies that a failed bulk read of the write log is not retried for every entry, and playback carries on with single reads.
+ */
+TEST_F(WearLevelingGeneral, Playback_BulkReadFailure_SingleAttempt) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        uint8_t test_val = 0x30 + i;
+        EXPECT_EQ(wear_leveling_write(0x01 + (i * 2), &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Refuse bulk reads of the write log, the consolidated data and its checksum still read fine
+    inst.set_read_bulk_callback([](std::uint64_t count, std::uint32_t address) { return address < WEAR_LEVELING_LOGICAL_SIZE + 8; });
+    uint64_t read_bulk_count = inst.read_bulk_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(inst.read_bulk_invoke_count(), read_bulk_count + 3) << "Failed bulk read of the write log should not have been retried";
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        uint8_t test_val = 0;
+        wear_leveling_read(0x01 + (i * 2), &test_val, sizeof(test_val));
+        EXPECT_EQ(test_val, 0x30 + i) << "Readback should match the played back write log";
+    }
+}
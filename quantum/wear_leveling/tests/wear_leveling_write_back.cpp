@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingWriteBack : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+/**
+ * This test verifies that writes only reach the cache until the task runs.
+ */
+TEST_F(WearLevelingWriteBack, WriteDefersBackingStore) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint64_t write_count = inst.write_invoke_count();
+    uint64_t erase_count = inst.erase_invoke_count();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Write should not have touched the backing store";
+    EXPECT_EQ(inst.erase_invoke_count(), erase_count) << "Write should not have erased the backing store";
+    EXPECT_TRUE(wear_leveling_pending()) << "Write should be pending";
+
+    uint8_t readback = 0;
+    EXPECT_EQ(wear_leveling_read(0x02, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Read should have succeeded";
+    EXPECT_EQ(readback, test_val) << "Read should be served from the cache";
+
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should have succeeded";
+    EXPECT_GT(inst.write_invoke_count(), write_count) << "Task should have appended to the write log";
+    EXPECT_FALSE(wear_leveling_pending()) << "Nothing should be pending after the task";
+
+    // Playback from the backing store returns the written value
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    readback = 0;
+    EXPECT_EQ(wear_leveling_read(0x02, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Read should have succeeded";
+    EXPECT_EQ(readback, test_val) << "Invalid readback";
+}
+
+/**
+ * This test verifies that the task appends one block per call, and that repeated writes to a block are appended once.
+ */
+TEST_F(WearLevelingWriteBack, TaskAppendsIncrementally) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t first = 0x21, second = 0x22;
+    EXPECT_EQ(wear_leveling_write(0x00, &first, sizeof(first)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(wear_leveling_write(0x00, &second, sizeof(second)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(wear_leveling_write(0x0C, &first, sizeof(first)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should have succeeded";
+    EXPECT_TRUE(wear_leveling_pending()) << "Second block should still be pending";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should have succeeded";
+    EXPECT_FALSE(wear_leveling_pending()) << "Nothing should be pending after two tasks";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle task should have succeeded";
+
+    // Each block is appended once, as two single byte entries and one zero word entry
+    EXPECT_EQ(inst.write_invoke_count() - write_count, 6) << "Each dirty block should be appended once";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        EXPECT_EQ(readback[i], i == 0x00 ? second : i == 0x0C ? first : 0x00) << "Invalid readback";
+    }
+}
+
+/**
+ * This test verifies that a flush consolidates when the log fills up, and leaves nothing pending.
+ */
+TEST_F(WearLevelingWriteBack, FlushConsolidates) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Write should not have erased the backing store";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush should have consolidated";
+    EXPECT_FALSE(wear_leveling_pending()) << "Nothing should be pending after a flush";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Empty flush should have succeeded";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readback, testvalue) << "Invalid readback";
+}
+
+/**
+ * This test verifies that an erase drops pending writes.
+ */
+TEST_F(WearLevelingWriteBack, EraseDropsPending) {
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase should have succeeded";
+    EXPECT_FALSE(wear_leveling_pending()) << "Nothing should be pending after an erase";
+}
+
+/**
+ * This test verifies that a block stays pending when appending it to the backing store fails, and is retried by the next task.
+ */
+TEST_F(WearLevelingWriteBack, WriteFailureKeepsPending) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return false; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Task should have failed";
+    EXPECT_TRUE(wear_leveling_pending()) << "Failed block should still be pending";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return true; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should have succeeded";
+    EXPECT_FALSE(wear_leveling_pending()) << "Nothing should be pending after the retry";
+
+    uint8_t readback = 0;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0x02, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Read should have succeeded";
+    EXPECT_EQ(readback, test_val) << "Invalid readback";
+}
@@ -66,7 +66,9 @@
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is fetched in bulk reads of
+                WEAR_LEVELING_PLAYBACK_READ_SIZE bytes rather than one backing
+                store write size at a time.
 
         During reads:
             * Logical data is served from the cache.
@@ -153,7 +155,19 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Write-back mode (WEAR_LEVELING_WRITE_BACK):
+
+        Writes only update the cache and flag the touched blocks of
+        WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE bytes as pending. wear_leveling_task()
+        later appends a few pending blocks per call to the write log, taking
+        any consolidation with it, so the caller of a write never waits on the
+        backing store. wear_leveling_flush() appends everything that is left. */
+
+#ifdef WEAR_LEVELING_WRITE_BACK
+#    define WEAR_LEVELING_WRITE_BACK_BLOCKS (((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE)-1) / (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE))
+#endif
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,6 +176,11 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_WRITE_BACK
+    uint8_t  pending[(WEAR_LEVELING_WRITE_BACK_BLOCKS + 7) / 8];
+    uint32_t pending_count;
+    uint32_t pending_next;
+#endif
 } wear_leveling;
 
 /**
@@ -203,6 +222,10 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#ifdef WEAR_LEVELING_WRITE_BACK
+    memset(wear_leveling.pending, 0, sizeof(wear_leveling.pending));
+    wear_leveling.pending_count = 0;
+#endif
 }
 
 /**
@@ -314,6 +337,13 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
     }
+#ifdef WEAR_LEVELING_WRITE_BACK
+    else {
+        // The consolidated data now holds every pending write
+        memset(wear_leveling.pending, 0, sizeof(wear_leveling.pending));
+        wear_leveling.pending_count = 0;
+    }
+#endif
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
@@ -469,18 +499,63 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Section of the write log held in RAM during playback.
+ */
+typedef struct wear_leveling_playback_window_t {
+    backing_store_int_t values[(WEAR_LEVELING_PLAYBACK_READ_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t            address;
+    uint32_t            count;
+    uint32_t            limit; // end of the range bulk reads are attempted in
+} wear_leveling_playback_window_t;
+
+/**
+ * Reads a value of the write log through the playback window, refilling it with a bulk read when the address falls outside.
+ */
+static bool wear_leveling_playback_read(wear_leveling_playback_window_t *window, uint32_t address, backing_store_int_t *value) {
+    if (address >= (WEAR_LEVELING_BACKING_SIZE)) {
+        return false;
+    }
+
+    if (address < window->address || address >= window->address + window->count * (BACKING_STORE_WRITE_SIZE)) {
+        if (address >= window->limit) {
+            return backing_store_read(address, value);
+        }
+
+        uint32_t count     = sizeof(window->values) / sizeof(backing_store_int_t);
+        uint32_t remaining = (window->limit - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > remaining) {
+            count = remaining;
+        }
+
+        window->count = 0;
+        if (!backing_store_read_bulk(address, window->values, count)) {
+            // The window may reach past the end of the log into locations the backing store refuses to read,
+            // read the rest of the log one value at a time rather than failing the same bulk read for every value
+            window->limit = address;
+            return backing_store_read(address, value);
+        }
+        window->address = address;
+        window->count   = count;
+    }
+
+    *value = window->values[(address - window->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling_playback_window_t window          = {.limit = (WEAR_LEVELING_BACKING_SIZE)};
+    wear_leveling_status_t          status          = WEAR_LEVELING_SUCCESS;
+    bool                            cancel_playback = false;
+    uint32_t                        address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
     while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_playback_read(&window, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +584,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_playback_read(&window, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +604,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_playback_read(&window, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +614,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_playback_read(&window, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +625,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_playback_read(&window, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -691,6 +766,17 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_WRITE_BACK
+    // Leave the backing store to wear_leveling_task(), it appends the cached values later
+    for (uint32_t block = address / (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE); block <= (address + length - 1) / (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE); ++block) {
+        if (!(wear_leveling.pending[block / 8] & (1 << (block % 8)))) {
+            wear_leveling.pending[block / 8] |= (1 << (block % 8));
+            wear_leveling.pending_count++;
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+#endif
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -726,6 +812,94 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+#ifdef WEAR_LEVELING_WRITE_BACK
+/**
+ * Appends the next pending block to the write log, taking turns through the logical data.
+ */
+static wear_leveling_status_t wear_leveling_write_back_next(void) {
+    uint32_t block = wear_leveling.pending_next;
+    while (!(wear_leveling.pending[block / 8] & (1 << (block % 8)))) {
+        // Skip whole bytes of clean blocks at once
+        block = (wear_leveling.pending[block / 8] == 0) ? (block / 8 + 1) * 8 : block + 1;
+        if (block >= WEAR_LEVELING_WRITE_BACK_BLOCKS) {
+            block = 0;
+        }
+    }
+    const uint32_t address = block * (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE);
+    const size_t   length  = (address + (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE) > (WEAR_LEVELING_LOGICAL_SIZE)) ? (WEAR_LEVELING_LOGICAL_SIZE) - address : (WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE);
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // The write log entries are encoded from the cache, which already holds the latest values
+    wear_leveling_status_t status = wear_leveling_write_raw(address, &wear_leveling.cache[address], length);
+    if (status == WEAR_LEVELING_FAILED) {
+        // Leave the block pending, the next task retries it
+        wear_leveling.pending_next = block;
+    } else {
+        // A consolidation during the write has already cleared every pending block
+        if (wear_leveling.pending[block / 8] & (1 << (block % 8))) {
+            wear_leveling.pending[block / 8] &= ~(1 << (block % 8));
+            wear_leveling.pending_count--;
+        }
+        wear_leveling.pending_next = (block + 1) % WEAR_LEVELING_WRITE_BACK_BLOCKS;
+        if (status == WEAR_LEVELING_SUCCESS) {
+            status = wear_leveling_consolidate_if_needed();
+        }
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Appends up to WEAR_LEVELING_WRITE_BACK_BLOCKS_PER_TASK pending blocks to the backing store.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < (WEAR_LEVELING_WRITE_BACK_BLOCKS_PER_TASK) && wear_leveling.pending_count > 0; ++i) {
+        status = wear_leveling_write_back_next();
+        if (status != WEAR_LEVELING_SUCCESS) {
+            // Either consolidation wrote out everything, or the backing store failed
+            break;
+        }
+    }
+    return status;
+}
+
+/**
+ * Appends every pending block to the backing store.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    while (wear_leveling.pending_count > 0) {
+        wear_leveling_status_t block_status = wear_leveling_write_back_next();
+        if (block_status == WEAR_LEVELING_FAILED) {
+            return WEAR_LEVELING_FAILED;
+        }
+        if (block_status == WEAR_LEVELING_CONSOLIDATED) {
+            status = WEAR_LEVELING_CONSOLIDATED;
+        }
+    }
+    return status;
+}
+
+/**
+ * Whether writes are waiting to be appended to the backing store.
+ */
+bool wear_leveling_pending(void) {
+    return wear_leveling.pending_count > 0;
+}
+#endif // WEAR_LEVELING_WRITE_BACK
+
 /**
  * Reads logical data from the cache.
  */
@@ -1,6 +1,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -52,3 +53,39 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_WRITE_BACK
+// Granularity of the pending write tracking, in bytes of logical data
+#    ifndef WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE
+#        define WEAR_LEVELING_WRITE_BACK_BLOCK_SIZE 4
+#    endif
+// Number of pending blocks appended to the write log by each wear_leveling_task() call
+#    ifndef WEAR_LEVELING_WRITE_BACK_BLOCKS_PER_TASK
+#        define WEAR_LEVELING_WRITE_BACK_BLOCKS_PER_TASK 1
+#    endif
+// Milliseconds without input before the main loop starts writing pending data back
+#    ifndef WEAR_LEVELING_WRITE_BACK_IDLE_TIME
+#        define WEAR_LEVELING_WRITE_BACK_IDLE_TIME 250
+#    endif
+
+/**
+ * Appends some of the pending writes to the backing store, consolidating if the write log fills up.
+ *
+ * With WEAR_LEVELING_WRITE_BACK, wear_leveling_write() only updates the cache and this needs to be called periodically.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Appends all pending writes to the backing store, ahead of a suspend or shutdown.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Whether the cache holds writes that have not reached the backing store yet.
+ */
+bool wear_leveling_pending(void);
+#endif // WEAR_LEVELING_WRITE_BACK
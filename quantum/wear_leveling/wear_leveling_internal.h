@@ -61,10 +61,16 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+// Number of bytes of the write log fetched per bulk read during playback
+#ifndef WEAR_LEVELING_PLAYBACK_READ_SIZE
+#    define WEAR_LEVELING_PLAYBACK_READ_SIZE 64
+#endif
+
 // Compile-time validation of configurable options
 _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_PLAYBACK_READ_SIZE % BACKING_STORE_WRITE_SIZE == 0 && WEAR_LEVELING_PLAYBACK_READ_SIZE > 0, "Playback read size must be a multiple of write size");
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -0,0 +1,38 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Reference figures for the key processing benchmarks, measured on a
+// development host with the default test build flags. Timings are the mean
+// wall-clock cost of one key event (press or release) including the scan
+// loops needed to resolve it, taken from the fastest of BENCHMARK_ROUNDS
+// rounds; stack figures are the deepest stack use seen while running a
+// scenario.
+//
+// Stack use is always checked. Timings are only enforced with
+// `make test:benchmark EXTRAFLAGS=-DBENCHMARK_CHECK_BASELINE`, as wall-clock
+// numbers vary between machines. Update them when an intentional change moves
+// the numbers: run `make test:benchmark EXTRAFLAGS=-DBENCHMARK_VERBOSE` and copy
+// the values from the `[ BENCH    ]` lines.
+
+#define BENCHMARK_BASELINE_TYPING_NS 13000
+#define BENCHMARK_BASELINE_TYPING_STACK 4184
+#define BENCHMARK_BASELINE_COMBO_NS 6200
+#define BENCHMARK_BASELINE_COMBO_STACK 3704
+#define BENCHMARK_BASELINE_TAP_DANCE_NS 25000
+#define BENCHMARK_BASELINE_TAP_DANCE_STACK 3496
+#define BENCHMARK_BASELINE_KEY_OVERRIDE_NS 18500
+#define BENCHMARK_BASELINE_KEY_OVERRIDE_STACK 3752
+#define BENCHMARK_BASELINE_LAYERS_NS 19000
+#define BENCHMARK_BASELINE_LAYERS_STACK 3672
+
+// Allowed slack before a run counts as a regression. Even the fastest round
+// varies by about a third between runs, so timings get a wider margin than
+// stack use.
+#ifndef BENCHMARK_TIME_TOLERANCE_PERCENT
+#    define BENCHMARK_TIME_TOLERANCE_PERCENT 50
+#endif
+#ifndef BENCHMARK_STACK_TOLERANCE_PERCENT
+#    define BENCHMARK_STACK_TOLERANCE_PERCENT 25
+#endif
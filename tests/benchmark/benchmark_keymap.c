@@ -0,0 +1,162 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "benchmark_keymap.h"
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_ESC_CAPS] = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+    [TD_BRACKETS] = ACTION_TAP_DANCE_DOUBLE(KC_LBRC, KC_RBRC),
+};
+// clang-format on
+
+const key_override_t delete_key_override      = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t volume_up_override       = ko_make_basic(MOD_MASK_CTRL, KC_DOT, KC_VOLU);
+const key_override_t volume_down_override     = ko_make_basic(MOD_MASK_CTRL, KC_COMM, KC_VOLD);
+const key_override_t brightness_up_override   = ko_make_basic(MOD_MASK_ALT, KC_DOT, KC_BRIU);
+const key_override_t brightness_down_override = ko_make_basic(MOD_MASK_ALT, KC_COMM, KC_BRID);
+const key_override_t next_track_override      = ko_make_with_layers(MOD_MASK_SHIFT, KC_RGHT, KC_MNXT, 1 << 1);
+const key_override_t prev_track_override      = ko_make_with_layers(MOD_MASK_SHIFT, KC_LEFT, KC_MPRV, 1 << 1);
+const key_override_t grave_escape_override    = ko_make_basic(MOD_MASK_GUI, KC_ESC, KC_GRV);
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &delete_key_override,
+    &volume_up_override,
+    &volume_down_override,
+    &brightness_up_override,
+    &brightness_down_override,
+    &next_track_override,
+    &prev_track_override,
+    &grave_escape_override,
+    NULL
+};
+// clang-format on
+
+// Dense chording layout: every horizontal and vertical neighbour pair on the
+// alpha block is a combo, plus a handful of three key rolls.
+
+// clang-format off
+const uint16_t PROGMEM cmb_q_w[] = {KC_Q, KC_W, COMBO_END};
+const uint16_t PROGMEM cmb_w_e[] = {KC_W, KC_E, COMBO_END};
+const uint16_t PROGMEM cmb_e_r[] = {KC_E, KC_R, COMBO_END};
+const uint16_t PROGMEM cmb_r_t[] = {KC_R, KC_T, COMBO_END};
+const uint16_t PROGMEM cmb_t_y[] = {KC_T, KC_Y, COMBO_END};
+const uint16_t PROGMEM cmb_y_u[] = {KC_Y, KC_U, COMBO_END};
+const uint16_t PROGMEM cmb_u_i[] = {KC_U, KC_I, COMBO_END};
+const uint16_t PROGMEM cmb_i_o[] = {KC_I, KC_O, COMBO_END};
+const uint16_t PROGMEM cmb_o_p[] = {KC_O, KC_P, COMBO_END};
+const uint16_t PROGMEM cmb_a_s[] = {KC_A, KC_S, COMBO_END};
+const uint16_t PROGMEM cmb_s_d[] = {KC_S, KC_D, COMBO_END};
+const uint16_t PROGMEM cmb_d_f[] = {KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM cmb_f_g[] = {KC_F, KC_G, COMBO_END};
+const uint16_t PROGMEM cmb_g_h[] = {KC_G, KC_H, COMBO_END};
+const uint16_t PROGMEM cmb_h_j[] = {KC_H, KC_J, COMBO_END};
+const uint16_t PROGMEM cmb_j_k[] = {KC_J, KC_K, COMBO_END};
+const uint16_t PROGMEM cmb_k_l[] = {KC_K, KC_L, COMBO_END};
+const uint16_t PROGMEM cmb_l_scln[] = {KC_L, KC_SCLN, COMBO_END};
+const uint16_t PROGMEM cmb_z_x[] = {KC_Z, KC_X, COMBO_END};
+const uint16_t PROGMEM cmb_x_c[] = {KC_X, KC_C, COMBO_END};
+const uint16_t PROGMEM cmb_c_v[] = {KC_C, KC_V, COMBO_END};
+const uint16_t PROGMEM cmb_v_b[] = {KC_V, KC_B, COMBO_END};
+const uint16_t PROGMEM cmb_b_n[] = {KC_B, KC_N, COMBO_END};
+const uint16_t PROGMEM cmb_n_m[] = {KC_N, KC_M, COMBO_END};
+const uint16_t PROGMEM cmb_m_comm[] = {KC_M, KC_COMM, COMBO_END};
+const uint16_t PROGMEM cmb_comm_dot[] = {KC_COMM, KC_DOT, COMBO_END};
+const uint16_t PROGMEM cmb_dot_slsh[] = {KC_DOT, KC_SLSH, COMBO_END};
+const uint16_t PROGMEM cmb_q_a[] = {KC_Q, KC_A, COMBO_END};
+const uint16_t PROGMEM cmb_w_s[] = {KC_W, KC_S, COMBO_END};
+const uint16_t PROGMEM cmb_e_d[] = {KC_E, KC_D, COMBO_END};
+const uint16_t PROGMEM cmb_r_f[] = {KC_R, KC_F, COMBO_END};
+const uint16_t PROGMEM cmb_t_g[] = {KC_T, KC_G, COMBO_END};
+const uint16_t PROGMEM cmb_y_h[] = {KC_Y, KC_H, COMBO_END};
+const uint16_t PROGMEM cmb_u_j[] = {KC_U, KC_J, COMBO_END};
+const uint16_t PROGMEM cmb_i_k[] = {KC_I, KC_K, COMBO_END};
+const uint16_t PROGMEM cmb_o_l[] = {KC_O, KC_L, COMBO_END};
+const uint16_t PROGMEM cmb_p_scln[] = {KC_P, KC_SCLN, COMBO_END};
+const uint16_t PROGMEM cmb_a_z[] = {KC_A, KC_Z, COMBO_END};
+const uint16_t PROGMEM cmb_s_x[] = {KC_S, KC_X, COMBO_END};
+const uint16_t PROGMEM cmb_d_c[] = {KC_D, KC_C, COMBO_END};
+const uint16_t PROGMEM cmb_f_v[] = {KC_F, KC_V, COMBO_END};
+const uint16_t PROGMEM cmb_g_b[] = {KC_G, KC_B, COMBO_END};
+const uint16_t PROGMEM cmb_h_n[] = {KC_H, KC_N, COMBO_END};
+const uint16_t PROGMEM cmb_j_m[] = {KC_J, KC_M, COMBO_END};
+const uint16_t PROGMEM cmb_k_comm[] = {KC_K, KC_COMM, COMBO_END};
+const uint16_t PROGMEM cmb_l_dot[] = {KC_L, KC_DOT, COMBO_END};
+const uint16_t PROGMEM cmb_scln_slsh[] = {KC_SCLN, KC_SLSH, COMBO_END};
+const uint16_t PROGMEM cmb_q_w_e[] = {KC_Q, KC_W, KC_E, COMBO_END};
+const uint16_t PROGMEM cmb_e_r_t[] = {KC_E, KC_R, KC_T, COMBO_END};
+const uint16_t PROGMEM cmb_t_y_u[] = {KC_T, KC_Y, KC_U, COMBO_END};
+const uint16_t PROGMEM cmb_u_i_o[] = {KC_U, KC_I, KC_O, COMBO_END};
+const uint16_t PROGMEM cmb_a_s_d[] = {KC_A, KC_S, KC_D, COMBO_END};
+const uint16_t PROGMEM cmb_d_f_g[] = {KC_D, KC_F, KC_G, COMBO_END};
+const uint16_t PROGMEM cmb_g_h_j[] = {KC_G, KC_H, KC_J, COMBO_END};
+const uint16_t PROGMEM cmb_j_k_l[] = {KC_J, KC_K, KC_L, COMBO_END};
+const uint16_t PROGMEM cmb_z_x_c[] = {KC_Z, KC_X, KC_C, COMBO_END};
+const uint16_t PROGMEM cmb_c_v_b[] = {KC_C, KC_V, KC_B, COMBO_END};
+const uint16_t PROGMEM cmb_b_n_m[] = {KC_B, KC_N, KC_M, COMBO_END};
+const uint16_t PROGMEM cmb_m_comm_dot[] = {KC_M, KC_COMM, KC_DOT, COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(cmb_q_w,        KC_F1),
+    COMBO(cmb_w_e,        KC_F2),
+    COMBO(cmb_e_r,        KC_F3),
+    COMBO(cmb_r_t,        KC_F4),
+    COMBO(cmb_t_y,        KC_F5),
+    COMBO(cmb_y_u,        KC_F6),
+    COMBO(cmb_u_i,        KC_F7),
+    COMBO(cmb_i_o,        KC_F8),
+    COMBO(cmb_o_p,        KC_F9),
+    COMBO(cmb_a_s,        KC_F10),
+    COMBO(cmb_s_d,        KC_F11),
+    COMBO(cmb_d_f,        KC_F12),
+    COMBO(cmb_f_g,        KC_F13),
+    COMBO(cmb_g_h,        KC_F14),
+    COMBO(cmb_h_j,        KC_F15),
+    COMBO(cmb_j_k,        KC_F16),
+    COMBO(cmb_k_l,        KC_F17),
+    COMBO(cmb_l_scln,     KC_F18),
+    COMBO(cmb_z_x,        KC_F19),
+    COMBO(cmb_x_c,        KC_F20),
+    COMBO(cmb_c_v,        KC_F21),
+    COMBO(cmb_v_b,        KC_F22),
+    COMBO(cmb_b_n,        KC_F23),
+    COMBO(cmb_n_m,        KC_F24),
+    COMBO(cmb_m_comm,     KC_F1),
+    COMBO(cmb_comm_dot,   KC_F2),
+    COMBO(cmb_dot_slsh,   KC_F3),
+    COMBO(cmb_q_a,        KC_F4),
+    COMBO(cmb_w_s,        KC_F5),
+    COMBO(cmb_e_d,        KC_F6),
+    COMBO(cmb_r_f,        KC_F7),
+    COMBO(cmb_t_g,        KC_F8),
+    COMBO(cmb_y_h,        KC_F9),
+    COMBO(cmb_u_j,        KC_F10),
+    COMBO(cmb_i_k,        KC_F11),
+    COMBO(cmb_o_l,        KC_F12),
+    COMBO(cmb_p_scln,     KC_F13),
+    COMBO(cmb_a_z,        KC_F14),
+    COMBO(cmb_s_x,        KC_F15),
+    COMBO(cmb_d_c,        KC_F16),
+    COMBO(cmb_f_v,        KC_F17),
+    COMBO(cmb_g_b,        KC_F18),
+    COMBO(cmb_h_n,        KC_F19),
+    COMBO(cmb_j_m,        KC_F20),
+    COMBO(cmb_k_comm,     KC_F21),
+    COMBO(cmb_l_dot,      KC_F22),
+    COMBO(cmb_scln_slsh,  KC_F23),
+    COMBO(cmb_q_w_e,      KC_F24),
+    COMBO(cmb_e_r_t,      KC_F1),
+    COMBO(cmb_t_y_u,      KC_F2),
+    COMBO(cmb_u_i_o,      KC_F3),
+    COMBO(cmb_a_s_d,      KC_F4),
+    COMBO(cmb_d_f_g,      KC_F5),
+    COMBO(cmb_g_h_j,      KC_F6),
+    COMBO(cmb_j_k_l,      KC_F7),
+    COMBO(cmb_z_x_c,      KC_F8),
+    COMBO(cmb_c_v_b,      KC_F9),
+    COMBO(cmb_b_n_m,      KC_F10),
+    COMBO(cmb_m_comm_dot, KC_F11)
+};
+// clang-format on
@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+
+// Number of times each benchmark scenario is repeated.
+#define BENCHMARK_ITERATIONS 50
+
+// Number of timed rounds of BENCHMARK_ITERATIONS, the fastest one is reported.
+#define BENCHMARK_ROUNDS 5
@@ -0,0 +1,13 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE  = yes
+COMBO_ENABLE        = yes
+KEY_OVERRIDE_ENABLE = yes
+TAP_DANCE_ENABLE    = yes
+
+INTROSPECTION_KEYMAP_C = benchmark_keymap.c
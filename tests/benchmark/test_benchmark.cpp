@@ -0,0 +1,282 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <ucontext.h>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_logger.hpp"
+#include "benchmark_baseline.h"
+
+extern "C" {
+#include "benchmark_keymap.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// Each scenario runs on a stack of its own, which is painted beforehand and
+// scanned afterwards to find the deepest write.
+#define BENCHMARK_STACK_SIZE (256 * 1024)
+#define BENCHMARK_STACK_PAINT 0xA5
+
+static uint8_t                benchmark_stack[BENCHMARK_STACK_SIZE] __attribute__((aligned(16)));
+static ucontext_t             caller_context;
+static ucontext_t             benchmark_context;
+static std::function<void()> *benchmark_body;
+
+static void benchmark_trampoline(void) {
+    (*benchmark_body)();
+}
+
+// Runs body on benchmark_stack and returns how many bytes of it were used.
+// The stack grows down, so anything touched has overwritten the paint from
+// the top; count the untouched bytes at the bottom.
+static size_t run_on_benchmark_stack(std::function<void()> body) {
+    memset(benchmark_stack, BENCHMARK_STACK_PAINT, sizeof(benchmark_stack));
+
+    benchmark_body = &body;
+    getcontext(&benchmark_context);
+    benchmark_context.uc_stack.ss_sp   = benchmark_stack;
+    benchmark_context.uc_stack.ss_size = sizeof(benchmark_stack);
+    benchmark_context.uc_link          = &caller_context;
+    makecontext(&benchmark_context, benchmark_trampoline, 0);
+    swapcontext(&caller_context, &benchmark_context);
+
+    size_t untouched = 0;
+    while (untouched < sizeof(benchmark_stack) && benchmark_stack[untouched] == BENCHMARK_STACK_PAINT) {
+        untouched++;
+    }
+    return sizeof(benchmark_stack) - untouched;
+}
+
+struct BenchmarkResult {
+    uint32_t events;
+    uint64_t ns_per_event;
+    size_t   stack_bytes;
+};
+
+// clang-format off
+static const uint16_t base_layer[MATRIX_ROWS][MATRIX_COLS] = {
+    {KC_Q,    KC_W,    KC_E,             KC_R,             KC_T,   KC_Y,    KC_U,   KC_I,    KC_O,    KC_P},
+    {KC_A,    KC_S,    KC_D,             KC_F,             KC_G,   KC_H,    KC_J,   KC_K,    KC_L,    KC_SCLN},
+    {KC_Z,    KC_X,    KC_C,             KC_V,             KC_B,   KC_N,    KC_M,   KC_COMM, KC_DOT,  KC_SLSH},
+    {KC_LSFT, KC_LCTL, TD(TD_ESC_CAPS),  TD(TD_BRACKETS),  KC_SPC, KC_BSPC, MO(1),  KC_LALT, KC_LGUI, KC_ENT}
+};
+
+static const uint16_t nav_layer[MATRIX_ROWS][MATRIX_COLS] = {
+    {KC_1,    KC_2,    KC_3,    KC_4,    KC_5,    KC_6,    KC_7,    KC_8,    KC_9,    KC_0},
+    {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_LEFT, KC_DOWN, KC_UP,   KC_RGHT, KC_TRNS},
+    {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_HOME, KC_PGDN, KC_PGUP, KC_END,  KC_TRNS},
+    {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS}
+};
+// clang-format on
+
+class Benchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        key_override_on();
+
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, base_layer[row][col]));
+                add_key(KeymapKey(1, col, row, nav_layer[row][col]));
+                // Two fully transparent layers on top, so lookups have to
+                // fall through the whole stack when they are enabled.
+                add_key(KeymapKey(2, col, row, KC_TRNS));
+                add_key(KeymapKey(3, col, row, KC_TRNS));
+            }
+        }
+    }
+
+    KeymapKey key(uint16_t keycode) {
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (base_layer[row][col] == keycode) {
+                    return KeymapKey(0, col, row, keycode);
+                }
+            }
+        }
+        ADD_FAILURE() << "keycode " << keycode << " is not on the base layer";
+        return KeymapKey(0, 0, 0, KC_NO);
+    }
+
+    void press(KeymapKey k) {
+        k.press();
+        run_one_scan_loop();
+        events++;
+    }
+
+    void release(KeymapKey k) {
+        k.release();
+        run_one_scan_loop();
+        events++;
+    }
+
+    void tap(KeymapKey k) {
+        press(k);
+        release(k);
+    }
+
+    void type(const char *text) {
+        for (const char *c = text; *c; c++) {
+            tap(key(*c == ' ' ? KC_SPC : KC_A + (*c - 'a')));
+        }
+    }
+
+    template <typename Workload>
+    BenchmarkResult measure(const char *name, Workload workload) {
+        // The fastest round is the one least disturbed by the rest of the host
+        BenchmarkResult result = {0, UINT64_MAX, 0};
+        for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+            events = 0;
+            std::chrono::steady_clock::time_point start, end;
+            size_t                                stack = run_on_benchmark_stack([&]() {
+                start = std::chrono::steady_clock::now();
+                for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+                    workload();
+                }
+                end = std::chrono::steady_clock::now();
+            });
+
+            uint64_t ns_per_event = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (events ? events : 1);
+            result.events         = events;
+            result.ns_per_event   = std::min(result.ns_per_event, ns_per_event);
+            result.stack_bytes    = std::max(result.stack_bytes, stack);
+        }
+
+        // Kept in the test log, which is only printed when a test fails
+        test_logger.info() << "benchmark " << name << ": " << result.events << " events, " << result.ns_per_event << " ns/event, " << result.stack_bytes << " bytes stack" << std::endl;
+#ifdef BENCHMARK_VERBOSE
+        std::cout << "[ BENCH    ] " << name << ": " << result.events << " events, " << result.ns_per_event << " ns/event, " << result.stack_bytes << " bytes stack" << std::endl;
+#endif
+        RecordProperty(std::string(name) + "_ns_per_event", std::to_string(result.ns_per_event));
+        RecordProperty(std::string(name) + "_stack_bytes", std::to_string(result.stack_bytes));
+        return result;
+    }
+
+    // Stack use only depends on the code and the compiler, so it is always held
+    // against the baseline. Wall-clock figures depend on the host, so they are
+    // only checked when BENCHMARK_CHECK_BASELINE is defined.
+    void expect_within_baseline(const BenchmarkResult &result, uint64_t baseline_ns, size_t baseline_stack) {
+        EXPECT_GT(result.events, 0u);
+        EXPECT_LE(result.stack_bytes, baseline_stack * (100 + BENCHMARK_STACK_TOLERANCE_PERCENT) / 100) << "stack use regressed against baseline of " << baseline_stack << " bytes";
+#ifdef BENCHMARK_CHECK_BASELINE
+        EXPECT_LE(result.ns_per_event, baseline_ns * (100 + BENCHMARK_TIME_TOLERANCE_PERCENT) / 100) << "per-event time regressed against baseline of " << baseline_ns << " ns";
+#endif
+        test_logger.info() << "  baseline: " << baseline_ns << " ns/event, " << baseline_stack << " bytes stack" << std::endl;
+    }
+
+   protected:
+    uint32_t events = 0;
+};
+
+TEST_F(Benchmark, typing) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    // Plain prose with a few dictionary typos, so autocorrect both matches
+    // and rewrites along the way.
+    auto result = measure("typing", [&]() { type("the quick brown fox jumps over teh lazy dog becuase it can "); });
+
+    expect_within_baseline(result, BENCHMARK_BASELINE_TYPING_NS, BENCHMARK_BASELINE_TYPING_STACK);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Benchmark, combos) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    auto chord = [&](std::initializer_list<uint16_t> keycodes) {
+        for (uint16_t keycode : keycodes) {
+            press(key(keycode));
+        }
+        for (uint16_t keycode : keycodes) {
+            release(key(keycode));
+        }
+    };
+
+    auto result = measure("combos", [&]() {
+        chord({KC_Q, KC_W});
+        chord({KC_S, KC_D});
+        chord({KC_E, KC_D});
+        chord({KC_C, KC_V, KC_B});
+        chord({KC_K, KC_COMM});
+        // A near miss: overlapping keys that never complete a combo.
+        chord({KC_A, KC_G});
+    });
+
+    expect_within_baseline(result, BENCHMARK_BASELINE_COMBO_NS, BENCHMARK_BASELINE_COMBO_STACK);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Benchmark, tap_dance) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    auto result = measure("tap_dance", [&]() {
+        tap(key(TD(TD_ESC_CAPS)));
+        idle_for(TAPPING_TERM);
+        tap(key(TD(TD_BRACKETS)));
+        tap(key(TD(TD_BRACKETS)));
+        idle_for(TAPPING_TERM);
+        // Interrupted by a regular key.
+        tap(key(TD(TD_ESC_CAPS)));
+        tap(key(KC_SPC));
+    });
+
+    expect_within_baseline(result, BENCHMARK_BASELINE_TAP_DANCE_NS, BENCHMARK_BASELINE_TAP_DANCE_STACK);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Benchmark, key_overrides) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(AnyNumber());
+
+    auto result = measure("key_overrides", [&]() {
+        press(key(KC_LSFT));
+        tap(key(KC_BSPC));
+        tap(key(KC_BSPC));
+        release(key(KC_LSFT));
+        press(key(KC_LCTL));
+        tap(key(KC_DOT));
+        tap(key(KC_COMM));
+        release(key(KC_LCTL));
+        // Modifier held with keys that have no override.
+        press(key(KC_LALT));
+        tap(key(KC_SPC));
+        release(key(KC_LALT));
+    });
+
+    expect_within_baseline(result, BENCHMARK_BASELINE_KEY_OVERRIDE_NS, BENCHMARK_BASELINE_KEY_OVERRIDE_STACK);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Benchmark, layers) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    layer_on(2);
+    layer_on(3);
+
+    auto result = measure("layers", [&]() {
+        press(key(MO(1)));
+        tap(KeymapKey(1, 5, 1, KC_LEFT));
+        tap(KeymapKey(1, 8, 1, KC_RGHT));
+        tap(KeymapKey(1, 0, 0, KC_1));
+        // Transparent on layer 1, resolved from the base layer.
+        tap(KeymapKey(1, 0, 1, KC_A));
+        release(key(MO(1)));
+        tap(key(KC_SPC));
+    });
+
+    expect_within_baseline(result, BENCHMARK_BASELINE_LAYERS_NS, BENCHMARK_BASELINE_LAYERS_STACK);
+    VERIFY_AND_CLEAR(driver);
+}
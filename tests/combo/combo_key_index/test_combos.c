@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { ab_combo, abc_combo, cd_combo, ef_combo };
+
+uint16_t const ab[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const abc[] = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const cd[]  = {KC_C, KC_D, COMBO_END};
+uint16_t const ef[]  = {KC_F, KC_E, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab_combo]  = COMBO(ab, KC_X),
+    [abc_combo] = COMBO(abc, KC_Y),
+    [cd_combo]  = COMBO(cd, KC_Z),
+    [ef_combo]  = COMBO(ef, KC_ENTER)
+};
+// clang-format on
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+static const key_override_t shift_one_on_layer_one = ko_make_with_layers(MOD_MASK_SHIFT, KC_1, KC_2, 1 << 1);
+static const key_override_t shift_one              = ko_make_basic(MOD_MASK_SHIFT, KC_1, KC_3);
+static const key_override_t shift_backspace        = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+static const key_override_t ctrl_a                 = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_B);
+
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &ctrl_a,
+    &shift_one_on_layer_one,
+    &shift_backspace,
+    &shift_one,
+    NULL,
+};
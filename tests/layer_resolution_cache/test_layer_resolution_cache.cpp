@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerResolutionCache : public TestFixture {};
+
+TEST_F(LayerResolutionCache, FallsThroughStackedTransparentLayers) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(2, 0, 0, KC_TRNS), KeymapKey(3, 0, 0, KC_TRNS), KeymapKey(4, 0, 0, KC_TRNS), KeymapKey(5, 0, 0, KC_TRNS)});
+    layer_or(0b111110);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, FollowsLayerStateChanges) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(2, 0, 0, KC_B), KeymapKey(3, 0, 0, KC_TRNS)});
+
+    layer_on(3);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+
+    layer_on(2);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+
+    layer_off(2);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, FollowsDirectLayerStateWrites) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_B)});
+
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    /* Split halves and eeconfig assign the state without going through layer_state_set(). */
+    layer_state = 0b10;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    default_layer_state = 0b11;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+    default_layer_state = 0b01;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, PicksUpKeymapChanges) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_TRNS)});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    /* Remap the key on the active layer, the fixture clears the cache like dynamic keymap writes do. */
+    set_keymap({key, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,180 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static bool playback_ready = true;
+
+extern "C" bool send_string_async_ready_user(void) {
+    return playback_ready;
+}
+
+class SendStringAsync : public TestFixture {
+   protected:
+    void SetUp() override {
+        playback_ready = true;
+    }
+};
+
+TEST_F(SendStringAsync, TypesOneCharacterPerPass) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("ab", 0));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_is_active());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelaysDoNotBlock) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a" SS_DELAY(50) "b", 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The delay code itself takes a pass, then the main loop keeps running while it elapses. */
+    EXPECT_NO_REPORT(driver);
+    idle_for(40);
+    EXPECT_TRUE(send_string_async_is_active());
+    EXPECT_LE(send_string_async_deadline(), 50U);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(15);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, PausesWhileNotReady) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    playback_ready = false;
+    send_string_async("a", 0);
+    idle_for(10);
+    EXPECT_TRUE(send_string_async_is_active());
+    EXPECT_EQ(send_string_async_deadline(), NO_DEADLINE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    playback_ready = true;
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, PlaysQueuedStringsInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a", 0);
+    send_string_async("b", 0);
+    idle_for(4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, RejectsStringsWhenFull) {
+    TestDriver driver;
+
+    for (uint8_t i = 0; i < SEND_STRING_ASYNC_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(send_string_async("a", 0));
+    }
+    EXPECT_FALSE(send_string_async("b", 0));
+
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_is_active());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, KeyPressCancelsPlayback) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_X);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("abc", 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X));
+    key.press();
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_is_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    send_string_async(SS_DOWN(X_LSFT) "a" SS_UP(X_LSFT), 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelKeepsPhysicallyHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+
+    set_keymap({shift});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_LEFT_CTRL));
+    send_string_async(SS_DOWN(X_LCTL) "a" SS_UP(X_LCTL), 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    send_string_async_cancel();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -182,6 +182,7 @@ void protocol_post_init(void) {
 
 void protocol_pre_task(void) {
     usb_event_queue_task();
+    usb_report_task();
 
 #if !defined(NO_USB_STARTUP_CHECK)
     if (USB_DRIVER.state == USB_SUSPENDED) {
@@ -11,6 +11,7 @@
 
 #include "usb_driver.h"
 #include "util.h"
+#include "wait.h"
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
@@ -74,6 +75,21 @@ static void obnotify(io_buffers_queue_t *bqp) {
     }
 }
 
+/**
+ * @brief   Returns the report stamp belonging to a buffer of the output buffers queue.
+ */
+static inline usb_report_stamp_t *usb_report_stamp(usb_endpoint_in_t *endpoint, uint8_t *buffer) {
+    return &endpoint->report_stamps[(size_t)(buffer - endpoint->obqueue.buffers) / endpoint->obqueue.bsize];
+}
+
+/**
+ * @brief   Resets the output buffers queue, dropping all queued reports.
+ */
+static void usb_endpoint_in_reset_queue(usb_endpoint_in_t *endpoint) {
+    obqResetI(&endpoint->obqueue);
+    memset(endpoint->report_stamps, 0, sizeof(usb_report_stamp_t) * endpoint->config.buffer_capacity);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -123,7 +139,7 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint) {
     endpoint->config.usbp->in_params[endpoint->config.ep - 1U] = NULL;
 
     bqSuspendI(&endpoint->obqueue);
-    obqResetI(&endpoint->obqueue);
+    usb_endpoint_in_reset_queue(endpoint);
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
     }
@@ -145,7 +161,7 @@ void usb_endpoint_out_stop(usb_endpoint_out_t *endpoint) {
 
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint) {
     bqSuspendI(&endpoint->obqueue);
-    obqResetI(&endpoint->obqueue);
+    usb_endpoint_in_reset_queue(endpoint);
 
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
@@ -167,7 +183,7 @@ void usb_endpoint_out_wakeup_cb(usb_endpoint_out_t *endpoint) {
 
 void usb_endpoint_in_configure_cb(usb_endpoint_in_t *endpoint) {
     usbInitEndpointI(endpoint->config.usbp, endpoint->config.ep, &endpoint->ep_config);
-    obqResetI(&endpoint->obqueue);
+    usb_endpoint_in_reset_queue(endpoint);
     bqResumeX(&endpoint->obqueue);
 }
 
@@ -199,6 +215,15 @@ void usb_endpoint_in_tx_complete_cb(USBDriver *usbp, usbep_t ep) {
 
     /* Freeing the buffer just transmitted, if it was not a zero size packet.*/
     if (!obqIsEmptyI(&endpoint->obqueue) && usbp->epc[ep]->in_state->txsize > 0U) {
+        /* Note when the host picked up a report sent with
+         * `usb_endpoint_in_send_latest`, for latency measurements. */
+        usb_report_stamp_t *stamp = usb_report_stamp(endpoint, endpoint->obqueue.brdptr);
+        if (stamp->valid) {
+            endpoint->last_report.queued    = stamp->queued;
+            endpoint->last_report.completed = osalOsGetSystemTimeX();
+            stamp->valid                    = false;
+        }
+
         /* Store the last send report in the endpoint to be retrieved by a
          * GET_REPORT request or IDLE report handling. */
         if (endpoint->report_storage != NULL) {
@@ -225,6 +250,9 @@ void usb_endpoint_in_tx_complete_cb(USBDriver *usbp, usbep_t ep) {
         /* Nothing to transmit.*/
     }
 
+    /* Space was freed, let an idle main loop flush its pending reports. */
+    wait_idle_wakeup_i();
+
     osalSysUnlockFromISR();
 }
 
@@ -247,6 +275,9 @@ void usb_endpoint_out_rx_complete_cb(USBDriver *usbp, usbep_t ep) {
      * next transaction.*/
     usb_start_receive(endpoint);
 
+    /* Data arrived for the main loop to handle. */
+    wait_idle_wakeup_i();
+
     osalSysUnlockFromISR();
 }
 
@@ -276,7 +307,7 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
             osalSysLock();
             endpoint->timed_out |= sent == 0;
             bqSuspendI(&endpoint->obqueue);
-            obqResetI(&endpoint->obqueue);
+            usb_endpoint_in_reset_queue(endpoint);
             bqResumeX(&endpoint->obqueue);
             osalOsRescheduleS();
             osalSysUnlock();
@@ -291,6 +322,88 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     }
 }
 
+/**
+ * @brief Send a report that carries a state, without ever waiting for the
+ * host. While the host keeps polling every report is queued as usual. Once the
+ * queue is full the report is merged into the most recent queued report of the
+ * same kind that has not been picked up yet, if `merge` allows it.
+ *
+ * @param endpoint USB IN endpoint to send the report from
+ * @param data pointer to the report
+ * @param size size of the report
+ * @param keyed the first byte is a report ID, only reports with the same ID are merged
+ * @param merge merges the report into a queued one
+ * @return true The report was queued or merged
+ * @return false The report could not be queued, the caller has to retry later
+ */
+bool usb_endpoint_in_send_latest(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, bool keyed, report_merge_t merge) {
+    osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U) && (size <= endpoint->config.buffer_size) && (merge != NULL));
+
+    output_buffers_queue_t *obqp = &endpoint->obqueue;
+    bool                    sent = false;
+
+    osalSysLock();
+    if (usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE || obqp->ptr != NULL) {
+        /* Not configured, or a buffered report is being assembled. */
+        osalSysUnlock();
+        return false;
+    }
+
+    if (obqGetEmptyBufferTimeoutS(obqp, TIME_IMMEDIATE) == MSG_OK) {
+        usb_report_stamp_t *stamp = usb_report_stamp(endpoint, obqp->bwrptr);
+        stamp->queued             = osalOsGetSystemTimeX();
+        stamp->valid              = true;
+        memcpy(obqp->ptr, data, size);
+        obqPostFullBufferS(obqp, size);
+        sent = true;
+    } else {
+        /* The host is not picking up reports, look for the most recent queued
+         * one to merge into, and the one of the same kind queued before it.
+         * The buffer being transmitted is never merged into. */
+        bool     transmitting = usbGetTransmitStatusI(endpoint->config.usbp, endpoint->config.ep);
+        uint8_t *queued       = NULL;
+        uint8_t *previous     = NULL;
+        uint8_t *buffer       = obqp->bwrptr;
+        for (size_t i = obqp->bn - obqp->bcounter; i > 0; i--) {
+            buffer = (buffer == obqp->buffers ? obqp->btop : buffer) - obqp->bsize;
+            if (*((size_t *)buffer) != size || (keyed && buffer[sizeof(size_t)] != data[0])) {
+                continue;
+            }
+
+            if (queued != NULL) {
+                previous = buffer + sizeof(size_t);
+                break;
+            }
+            if (transmitting && buffer == obqp->brdptr) {
+                break;
+            }
+            queued = buffer + sizeof(size_t);
+        }
+
+        /* Keeps the timestamp of the queued report, it is the oldest change. */
+        if (queued != NULL) {
+            sent = merge(queued, previous, data, size);
+        }
+    }
+    osalSysUnlock();
+
+    return sent;
+}
+
+/**
+ * @brief Timestamps of the last report sent with `usb_endpoint_in_send_latest`
+ * that was picked up by the host.
+ */
+usb_report_timestamp_t usb_endpoint_in_last_report(usb_endpoint_in_t *endpoint) {
+    osalDbgCheck(endpoint != NULL);
+
+    osalSysLock();
+    usb_report_timestamp_t timestamp = endpoint->last_report;
+    osalSysUnlock();
+
+    return timestamp;
+}
+
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded) {
     osalDbgCheck(endpoint != NULL);
 
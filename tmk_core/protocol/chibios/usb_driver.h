@@ -10,6 +10,7 @@
 #include "usb_descriptor.h"
 #include "chibios_config.h"
 #include "usb_report_handling.h"
+#include "report_queue.h"
 #include "string.h"
 #include "timer.h"
 
@@ -54,7 +55,8 @@
             .buffer_capacity = _buffer_capacity,                                                        \
             .buffer_size     = ep_size,                                                                 \
             .buffer          = (_Alignas(4) uint8_t[BQ_BUFFER_SIZE(_buffer_capacity, ep_size)]){0},     \
-        }                                                                                               \
+        },                                                                                              \
+        .report_stamps = (usb_report_stamp_t[_buffer_capacity]){0},                                     \
     }
 
 #if !defined(USB_ENDPOINTS_ARE_REORDERABLE)
@@ -105,7 +107,8 @@
                 .buffer_capacity = _buffer_capacity,                                                               \
                 .buffer_size     = ep_size,                                                                        \
                 .buffer          = (_Alignas(4) uint8_t[BQ_BUFFER_SIZE(_buffer_capacity, ep_size)]){0},            \
-            }                                                                                                      \
+            },                                                                                                     \
+            .report_stamps = (usb_report_stamp_t[_buffer_capacity]){0},                                            \
         }
 
 /* The current assumption is that there are no standalone OUT endpoints, so the
@@ -154,6 +157,26 @@ typedef struct {
     uint8_t *buffer;
 } usb_endpoint_config_t;
 
+/**
+ * @brief Timestamps of a report sent with `usb_endpoint_in_send_latest`, in system ticks
+ */
+typedef struct {
+    /**
+     * @brief When the oldest change carried by the report was queued
+     */
+    systime_t queued;
+
+    /**
+     * @brief When the host picked the report up
+     */
+    systime_t completed;
+} usb_report_timestamp_t;
+
+typedef struct {
+    systime_t queued;
+    bool      valid;
+} usb_report_stamp_t;
+
 typedef struct {
     output_buffers_queue_t obqueue;
     USBEndpointConfig      ep_config;
@@ -162,10 +185,12 @@ typedef struct {
     USBOutEndpointState ep_out_state;
     bool                is_shared;
 #endif
-    usb_endpoint_config_t config;
-    usbreqhandler_t       usb_requests_cb;
-    bool                  timed_out;
-    usb_report_storage_t *report_storage;
+    usb_endpoint_config_t  config;
+    usbreqhandler_t        usb_requests_cb;
+    bool                   timed_out;
+    usb_report_storage_t * report_storage;
+    usb_report_stamp_t *   report_stamps;
+    usb_report_timestamp_t last_report;
 } usb_endpoint_in_t;
 
 typedef struct {
@@ -185,6 +210,8 @@ void usb_endpoint_in_start(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint);
 
 bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout, bool buffered);
+bool usb_endpoint_in_send_latest(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, bool keyed, report_merge_t merge);
+usb_report_timestamp_t usb_endpoint_in_last_report(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded);
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint);
 
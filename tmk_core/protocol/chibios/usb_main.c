@@ -61,6 +61,7 @@ uint8_t keyboard_led_state            = 0;
 static bool __attribute__((__unused__)) send_report_buffered(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 static void __attribute__((__unused__)) flush_report_buffered(usb_endpoint_in_lut_t endpoint, bool padded);
 static bool __attribute__((__unused__)) receive_report(usb_endpoint_out_lut_t endpoint, void *report, size_t size);
+static void reset_pending_reports(void);
 
 /* ---------------------------------------------------------
  *            Descriptors and USB driver objects
@@ -117,6 +118,11 @@ static inline bool usb_event_queue_enqueue(usbevent_t event) {
     }
     event_queue[event_queue_head] = event;
     event_queue_head              = next;
+#ifdef KEYBOARD_IDLE_SLEEP
+    osalSysLockFromISR();
+    wait_idle_wakeup_i();
+    osalSysUnlockFromISR();
+#endif
     return true;
 }
 
@@ -168,6 +174,8 @@ void usb_event_queue_task(void) {
                 break;
             case USB_EVENT_RESET:
                 usb_device_state_set_reset();
+                /* The host starts over, don't send it old states */
+                reset_pending_reports();
                 break;
             default:
                 // Nothing to do, we don't handle it.
@@ -434,18 +442,117 @@ static bool receive_report(usb_endpoint_out_lut_t endpoint, void *report, size_t
     return usb_endpoint_out_receive(&usb_endpoints_out[endpoint], (uint8_t *)report, size, TIME_IMMEDIATE);
 }
 
+/* ---------------------------------------------------------
+ *                  State report functions
+ * ---------------------------------------------------------
+ */
+
+/* Reports carrying a state are sent without waiting for the host. Reports
+ * that can't be queued on the endpoint yet wait in a short FIFO, merged with
+ * the ones that follow where no change is lost, and are retried from
+ * `usb_report_task`. */
+typedef enum {
+    PENDING_REPORT_KEYBOARD,
+#ifdef NKRO_ENABLE
+    PENDING_REPORT_NKRO,
+#endif
+#ifdef MOUSE_ENABLE
+    PENDING_REPORT_MOUSE,
+#endif
+    PENDING_REPORT_COUNT,
+} pending_report_t;
+
+typedef struct {
+    usb_endpoint_in_lut_t endpoint;
+    report_queue_t        queue;
+} usb_pending_reports_t;
+
+static usb_pending_reports_t pending_reports[PENDING_REPORT_COUNT] = {
+    [PENDING_REPORT_KEYBOARD] = {.endpoint = USB_ENDPOINT_IN_KEYBOARD, .queue = {.merge = report_merge_keyboard}},
+#ifdef NKRO_ENABLE
+    [PENDING_REPORT_NKRO] = {.endpoint = USB_ENDPOINT_IN_SHARED, .queue = {.merge = report_merge_nkro}},
+#endif
+#ifdef MOUSE_ENABLE
+    [PENDING_REPORT_MOUSE] = {.endpoint = USB_ENDPOINT_IN_MOUSE, .queue = {.merge = report_merge_mouse}},
+#endif
+};
+
+static void reset_pending_reports(void) {
+    for (int i = 0; i < PENDING_REPORT_COUNT; i++) {
+        report_queue_clear(&pending_reports[i].queue);
+    }
+}
+
+static inline bool is_shared_endpoint(usb_endpoint_in_lut_t endpoint) {
+#ifdef SHARED_EP_ENABLE
+    return endpoint == USB_ENDPOINT_IN_SHARED;
+#else
+    return false;
+#endif
+}
+
+static void send_pending_reports(usb_pending_reports_t *pending) {
+    const uint8_t *report;
+    size_t         size;
+
+    while ((report = report_queue_peek(&pending->queue, &size)) != NULL) {
+        if (!usb_endpoint_in_send_latest(&usb_endpoints_in[pending->endpoint], report, size, is_shared_endpoint(pending->endpoint), pending->queue.merge)) {
+            return;
+        }
+        report_queue_pop(&pending->queue);
+    }
+}
+
+/**
+ * @brief Send a report carrying a state to the host, without waiting for the
+ * host to pick up earlier reports.
+ *
+ * @param index pending report queue of the report
+ * @param report pointer to the report
+ * @param size size of the report
+ */
+static void send_report_latest(pending_report_t index, const void *report, size_t size) {
+    usb_pending_reports_t *pending = &pending_reports[index];
+
+    /* Keep the reports in order, the earlier ones have to go first */
+    send_pending_reports(pending);
+    report_queue_push(&pending->queue, report, size);
+    send_pending_reports(pending);
+}
+
+/**
+ * @brief Retry the reports that couldn't be queued yet, to be called from the
+ * main loop.
+ */
+void usb_report_task(void) {
+    for (int i = 0; i < PENDING_REPORT_COUNT; i++) {
+        send_pending_reports(&pending_reports[i]);
+    }
+}
+
+/**
+ * @brief Timestamps of the last state report that was picked up by the host,
+ * in system ticks. `chTimeDiffX(timestamp.queued, timestamp.completed)` is the
+ * time the report waited for the host.
+ *
+ * @param endpoint USB IN endpoint the report was sent from
+ */
+usb_report_timestamp_t usb_get_report_timestamp(usb_endpoint_in_lut_t endpoint) {
+    return usb_endpoint_in_last_report(&usb_endpoints_in[endpoint]);
+}
+
 void send_keyboard(report_keyboard_t *report) {
     /* If we're in Boot Protocol, don't send any report ID or other funky fields */
     if (!keyboard_protocol) {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, &report->mods, 8);
+        send_report_latest(PENDING_REPORT_KEYBOARD, &report->mods, 8);
     } else {
-        send_report(USB_ENDPOINT_IN_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
+        send_report_latest(PENDING_REPORT_KEYBOARD, report, KEYBOARD_REPORT_SIZE);
     }
 }
 
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
-    send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
+    send_report_latest(PENDING_REPORT_NKRO, report, sizeof(report_nkro_t));
 #endif
 }
 
@@ -456,7 +563,7 @@ void send_nkro(report_nkro_t *report) {
 
 void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
-    send_report(USB_ENDPOINT_IN_MOUSE, report, sizeof(report_mouse_t));
+    send_report_latest(PENDING_REPORT_MOUSE, report, sizeof(report_mouse_t));
 #endif
 }
 
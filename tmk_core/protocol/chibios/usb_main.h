@@ -34,6 +34,10 @@ void usb_start(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+void usb_report_task(void);
+
+usb_report_timestamp_t usb_get_report_timestamp(usb_endpoint_in_lut_t endpoint);
+
 /* ---------------
  * USB Event queue
  * ---------------
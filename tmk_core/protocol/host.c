@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "profiling.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -84,7 +85,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
-    (*driver->send_keyboard)(report);
+    PROFILE_SLOT(PROFILE_REPORT_SEND, (*driver->send_keyboard)(report));
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -98,7 +99,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
-    (*driver->send_nkro)(report);
+    PROFILE_SLOT(PROFILE_REPORT_SEND, (*driver->send_nkro)(report));
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
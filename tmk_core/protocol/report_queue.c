@@ -0,0 +1,162 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "report_queue.h"
+
+static inline uint8_t report_queue_index(report_queue_t *queue, uint8_t offset) {
+    return (queue->head + offset) % REPORT_QUEUE_SIZE;
+}
+
+void report_queue_clear(report_queue_t *queue) {
+    queue->head      = 0;
+    queue->count     = 0;
+    queue->sent_size = 0;
+}
+
+bool report_queue_push(report_queue_t *queue, const void *report, size_t size) {
+    if (size > sizeof(report_queue_entry_t)) {
+        return false;
+    }
+
+    if (queue->count > 0) {
+        uint8_t tail = report_queue_index(queue, queue->count - 1);
+
+        if (queue->sizes[tail] == size) {
+            const uint8_t *previous = NULL;
+            if (queue->count > 1) {
+                uint8_t before = report_queue_index(queue, queue->count - 2);
+                previous       = queue->sizes[before] == size ? queue->reports[before].raw : NULL;
+            } else if (queue->sent_size == size) {
+                previous = queue->sent.raw;
+            }
+            if (queue->merge(queue->reports[tail].raw, previous, report, size)) {
+                return true;
+            }
+        }
+
+        if (queue->count == REPORT_QUEUE_SIZE) {
+            /* The host stopped polling for longer than the queue lasts, keep
+             * the latest state rather than the newest change. */
+            memcpy(queue->reports[tail].raw, report, size);
+            queue->sizes[tail] = size;
+            return false;
+        }
+    }
+
+    uint8_t index = report_queue_index(queue, queue->count++);
+    memcpy(queue->reports[index].raw, report, size);
+    queue->sizes[index] = size;
+    return true;
+}
+
+const uint8_t *report_queue_peek(report_queue_t *queue, size_t *size) {
+    if (queue->count == 0) {
+        return NULL;
+    }
+    *size = queue->sizes[queue->head];
+    return queue->reports[queue->head].raw;
+}
+
+void report_queue_pop(report_queue_t *queue) {
+    if (queue->count == 0) {
+        return;
+    }
+    memcpy(queue->sent.raw, queue->reports[queue->head].raw, queue->sizes[queue->head]);
+    queue->sent_size = queue->sizes[queue->head];
+    queue->head      = report_queue_index(queue, 1);
+    queue->count--;
+}
+
+/* True if every key and modifier held in `from` is still held in `to`. The
+ * boot protocol report lacks the report ID, so the fields are found from the
+ * end of the report. */
+static bool keyboard_report_holds(const uint8_t *to, const uint8_t *from, size_t size) {
+    const uint8_t *to_keys   = to + size - KEYBOARD_REPORT_KEYS;
+    const uint8_t *from_keys = from + size - KEYBOARD_REPORT_KEYS;
+
+    if ((to_keys[-2] & from_keys[-2]) != from_keys[-2]) {
+        return false;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (from_keys[i] != 0 && memchr(to_keys, from_keys[i], KEYBOARD_REPORT_KEYS) == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* A key report is only replaced by one holding everything it holds, and never
+ * if it releases keys, or the host would miss a keystroke. */
+bool report_merge_keyboard(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size) {
+    if (memcmp(queued, report, size) == 0) {
+        return true;
+    }
+    if (previous == NULL || !keyboard_report_holds(queued, previous, size) || !keyboard_report_holds(report, queued, size)) {
+        return false;
+    }
+    memcpy(queued, report, size);
+    return true;
+}
+
+/* Same as `keyboard_report_holds`, NKRO reports are one bitmap after the report ID. */
+static bool nkro_report_holds(const uint8_t *to, const uint8_t *from, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        if ((to[i] & from[i]) != from[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool report_merge_nkro(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size) {
+    if (memcmp(queued, report, size) == 0) {
+        return true;
+    }
+    if (previous == NULL || !nkro_report_holds(queued, previous, size) || !nkro_report_holds(report, queued, size)) {
+        return false;
+    }
+    memcpy(queued, report, size);
+    return true;
+}
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MOUSE_REPORT_XY_MIN INT16_MIN
+#    define MOUSE_REPORT_XY_MAX INT16_MAX
+#else
+#    define MOUSE_REPORT_XY_MIN INT8_MIN
+#    define MOUSE_REPORT_XY_MAX INT8_MAX
+#endif
+
+static inline bool add_mouse_motion(int32_t *sum, int32_t motion, int32_t min, int32_t max) {
+    *sum += motion;
+    return *sum >= min && *sum <= max;
+}
+
+/* Mouse reports carry relative motion, so it is summed up as long as the buttons stay the same. */
+bool report_merge_mouse(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size) {
+    report_mouse_t *      into = (report_mouse_t *)queued;
+    const report_mouse_t *from = (const report_mouse_t *)report;
+
+    if (into->buttons != from->buttons) {
+        return false;
+    }
+
+    int32_t x = into->x, y = into->y, v = into->v, h = into->h;
+    if (!add_mouse_motion(&x, from->x, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX) || !add_mouse_motion(&y, from->y, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX) || !add_mouse_motion(&v, from->v, INT8_MIN, INT8_MAX) || !add_mouse_motion(&h, from->h, INT8_MIN, INT8_MAX)) {
+        return false;
+    }
+#ifdef MOUSE_EXTENDED_REPORT
+    int32_t boot_x = into->boot_x, boot_y = into->boot_y;
+    if (!add_mouse_motion(&boot_x, from->boot_x, INT8_MIN, INT8_MAX) || !add_mouse_motion(&boot_y, from->boot_y, INT8_MIN, INT8_MAX)) {
+        return false;
+    }
+    into->boot_x = boot_x;
+    into->boot_y = boot_y;
+#endif
+
+    into->x = x;
+    into->y = y;
+    into->v = v;
+    into->h = h;
+    return true;
+}
@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "report.h"
+
+/*
+    A short FIFO of state reports (keyboard, NKRO, mouse) that could not be
+    handed to the host yet. A new report is merged into the newest queued one
+    when no change the host has to see is lost, otherwise it is appended, so
+    the main loop never has to wait for the host to poll.
+*/
+
+#ifndef REPORT_QUEUE_SIZE
+#    define REPORT_QUEUE_SIZE 8
+#endif
+
+/**
+ * @brief Merges a report into one that is still queued, returns false if they can't be merged.
+ * `previous` is the report of the same kind sent before the queued one, NULL if it is not known.
+ */
+typedef bool (*report_merge_t)(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size);
+
+typedef union {
+    uint8_t           raw[1];
+    report_keyboard_t keyboard;
+    report_nkro_t     nkro;
+    report_mouse_t    mouse;
+} report_queue_entry_t;
+
+typedef struct {
+    report_merge_t       merge;
+    uint8_t              head;
+    uint8_t              count;
+    uint8_t              sizes[REPORT_QUEUE_SIZE];
+    report_queue_entry_t reports[REPORT_QUEUE_SIZE];
+    uint8_t              sent_size;
+    report_queue_entry_t sent;
+} report_queue_t;
+
+/**
+ * @brief Drops the queued reports and forgets the last sent one, e.g. on a bus reset.
+ */
+void report_queue_clear(report_queue_t *queue);
+
+/**
+ * @brief Queues a report behind the ones already waiting.
+ *
+ * @return true The report was merged or appended
+ * @return false The queue was full, the report replaced the newest queued one
+ */
+bool report_queue_push(report_queue_t *queue, const void *report, size_t size);
+
+/**
+ * @brief The oldest queued report, NULL if the queue is empty.
+ */
+const uint8_t *report_queue_peek(report_queue_t *queue, size_t *size);
+
+/**
+ * @brief Removes the oldest queued report once it was handed to the host.
+ */
+void report_queue_pop(report_queue_t *queue);
+
+bool report_merge_keyboard(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size);
+bool report_merge_nkro(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size);
+bool report_merge_mouse(uint8_t *queued, const uint8_t *previous, const uint8_t *report, size_t size);
@@ -0,0 +1,224 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cstring>
+#include <initializer_list>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "report_queue.h"
+}
+
+static report_keyboard_t keyboard_report(std::initializer_list<uint8_t> keys, uint8_t mods = 0) {
+    report_keyboard_t report = {};
+    report.report_id         = REPORT_ID_KEYBOARD;
+    report.mods              = mods;
+    uint8_t i                = 0;
+    for (uint8_t key : keys) {
+        report.keys[i++] = key;
+    }
+    return report;
+}
+
+static report_mouse_t mouse_report(uint8_t buttons, int8_t x, int8_t y) {
+    report_mouse_t report = {};
+    report.report_id      = REPORT_ID_MOUSE;
+    report.buttons        = buttons;
+    report.x              = x;
+    report.y              = y;
+    return report;
+}
+
+class ReportQueueTest : public ::testing::Test {
+   protected:
+    report_queue_t queue = {};
+
+    void use(report_merge_t merge) {
+        queue.merge = merge;
+        report_queue_clear(&queue);
+    }
+
+    template <typename T>
+    void expect_next(const T &expected) {
+        size_t         size   = 0;
+        const uint8_t *report = report_queue_peek(&queue, &size);
+        ASSERT_NE(report, nullptr);
+        ASSERT_EQ(size, sizeof(T));
+        EXPECT_EQ(memcmp(report, &expected, sizeof(T)), 0);
+        report_queue_pop(&queue);
+    }
+
+    void expect_empty() {
+        size_t size = 0;
+        EXPECT_EQ(report_queue_peek(&queue, &size), nullptr);
+    }
+};
+
+TEST_F(ReportQueueTest, KeepsEveryKeystrokeOfARepeatedKey) {
+    use(report_merge_keyboard);
+    auto a    = keyboard_report({KC_A});
+    auto none = keyboard_report({});
+
+    EXPECT_TRUE(report_queue_push(&queue, &a, sizeof(a)));
+    EXPECT_TRUE(report_queue_push(&queue, &none, sizeof(none)));
+    EXPECT_TRUE(report_queue_push(&queue, &a, sizeof(a)));
+
+    expect_next(a);
+    expect_next(none);
+    expect_next(a);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, MergesPressesIntoTheQueuedPress) {
+    use(report_merge_keyboard);
+    auto none = keyboard_report({});
+    auto a    = keyboard_report({KC_A});
+    auto ab   = keyboard_report({KC_A, KC_B});
+
+    EXPECT_TRUE(report_queue_push(&queue, &none, sizeof(none)));
+    EXPECT_TRUE(report_queue_push(&queue, &a, sizeof(a)));
+    EXPECT_TRUE(report_queue_push(&queue, &ab, sizeof(ab)));
+
+    expect_next(none);
+    expect_next(ab);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, MergesAgainstTheLastSentReport) {
+    use(report_merge_keyboard);
+    auto a   = keyboard_report({KC_A});
+    auto ab  = keyboard_report({KC_A, KC_B});
+    auto abc = keyboard_report({KC_A, KC_B, KC_C});
+
+    report_queue_push(&queue, &a, sizeof(a));
+    expect_next(a);
+
+    EXPECT_TRUE(report_queue_push(&queue, &ab, sizeof(ab)));
+    EXPECT_TRUE(report_queue_push(&queue, &abc, sizeof(abc)));
+    expect_next(abc);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, DoesNotMergeWithoutTheEarlierReport) {
+    use(report_merge_keyboard);
+    auto a  = keyboard_report({KC_A});
+    auto ab = keyboard_report({KC_A, KC_B});
+
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_push(&queue, &ab, sizeof(ab));
+
+    expect_next(a);
+    expect_next(ab);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, NeverMergesOverARelease) {
+    use(report_merge_keyboard);
+    auto shift_a = keyboard_report({KC_A}, MOD_BIT(KC_LEFT_SHIFT));
+    auto a       = keyboard_report({KC_A});
+    auto ab      = keyboard_report({KC_A, KC_B});
+
+    report_queue_push(&queue, &shift_a, sizeof(shift_a));
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_push(&queue, &ab, sizeof(ab));
+
+    expect_next(shift_a);
+    expect_next(a);
+    expect_next(ab);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, KeepsTheLatestStateWhenFull) {
+    use(report_merge_keyboard);
+    auto a    = keyboard_report({KC_A});
+    auto none = keyboard_report({});
+
+    for (int i = 0; i < REPORT_QUEUE_SIZE; i++) {
+        auto &report = i % 2 == 0 ? a : none;
+        EXPECT_TRUE(report_queue_push(&queue, &report, sizeof(report)));
+    }
+    EXPECT_FALSE(report_queue_push(&queue, &a, sizeof(a)));
+
+    for (int i = 0; i < REPORT_QUEUE_SIZE - 1; i++) {
+        expect_next(i % 2 == 0 ? a : none);
+    }
+    expect_next(a);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, DoesNotMergeReportsOfADifferentSize) {
+    use(report_merge_keyboard);
+    auto    a    = keyboard_report({KC_A});
+    uint8_t boot = 0;
+
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_push(&queue, &boot, sizeof(boot));
+
+    expect_next(a);
+    expect_next(boot);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, MergesNkroPresses) {
+    use(report_merge_nkro);
+    report_nkro_t none = {};
+    none.report_id     = REPORT_ID_NKRO;
+    report_nkro_t a    = none;
+    a.bits[KC_A / 8] |= 1 << (KC_A % 8);
+    report_nkro_t ab = a;
+    ab.bits[KC_B / 8] |= 1 << (KC_B % 8);
+
+    report_queue_push(&queue, &none, sizeof(none));
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_push(&queue, &ab, sizeof(ab));
+    report_queue_push(&queue, &a, sizeof(a));
+
+    expect_next(none);
+    expect_next(ab);
+    expect_next(a);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, SumsMouseMotionWhileTheButtonsStayTheSame) {
+    use(report_merge_mouse);
+    auto first   = mouse_report(0, 10, -5);
+    auto second  = mouse_report(0, 20, -5);
+    auto pressed = mouse_report(1, 1, 1);
+
+    report_queue_push(&queue, &first, sizeof(first));
+    report_queue_push(&queue, &second, sizeof(second));
+    report_queue_push(&queue, &pressed, sizeof(pressed));
+
+    expect_next(mouse_report(0, 30, -10));
+    expect_next(pressed);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, DoesNotOverflowMouseMotion) {
+    use(report_merge_mouse);
+    auto fast = mouse_report(0, 100, 0);
+
+    report_queue_push(&queue, &fast, sizeof(fast));
+    report_queue_push(&queue, &fast, sizeof(fast));
+
+    expect_next(fast);
+    expect_next(fast);
+    expect_empty();
+}
+
+TEST_F(ReportQueueTest, ClearForgetsQueuedAndSentReports) {
+    use(report_merge_keyboard);
+    auto a  = keyboard_report({KC_A});
+    auto ab = keyboard_report({KC_A, KC_B});
+
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_pop(&queue);
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_clear(&queue);
+    expect_empty();
+
+    report_queue_push(&queue, &a, sizeof(a));
+    report_queue_push(&queue, &ab, sizeof(ab));
+    expect_next(a);
+    expect_next(ab);
+    expect_empty();
+}
@@ -0,0 +1,8 @@
+report_queue_DEFS := -DNKRO_ENABLE -DMOUSE_ENABLE -DKEYBOARD_SHARED_EP -DMOUSE_SHARED_EP -DREPORT_QUEUE_SIZE=4
+
+report_queue_SRC := \
+    $(TMK_PATH)/protocol/tests/report_queue.cpp \
+    $(TMK_PATH)/protocol/report_queue.c
+
+report_queue_INC := \
+    $(TMK_PATH)/protocol